@@ -0,0 +1,84 @@
+#include <iris/coroutine_frame_pool.hpp>
+#include <iris/generator.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+template <typename Allocator>
+using generator
+    = iris::generator<const std::uint32_t&, std::uint32_t, Allocator>;
+
+// a complete binary tree stored in an array, the children of node `i` are
+// `2 * i + 1` and `2 * i + 2`.
+template <typename Allocator>
+generator<Allocator> walk(const std::vector<std::uint32_t>& tree,
+                          std::size_t node)
+{
+    co_yield tree[node];
+    if (auto left = 2 * node + 1; left < tree.size()) {
+        co_yield iris::ranges::elements_of(walk<Allocator>(tree, left));
+    }
+    if (auto right = 2 * node + 2; right < tree.size()) {
+        co_yield iris::ranges::elements_of(walk<Allocator>(tree, right));
+    }
+}
+
+// nests `depth` generators, the innermost one yields `count` values.
+template <typename Allocator>
+generator<Allocator> chain(std::size_t depth, std::uint32_t count)
+{
+    if (depth == 0) {
+        for (std::uint32_t i = 0; i < count; ++i) {
+            co_yield i;
+        }
+    } else {
+        co_yield iris::ranges::elements_of(
+            chain<Allocator>(depth - 1, count));
+    }
+}
+
+template <typename Generator>
+void measure(const char* name, std::size_t expected, Generator g)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t sum = 0;
+    std::size_t count = 0;
+    for (auto value : g) {
+        sum += value;
+        ++count;
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << count << " values in "
+              << elapsed.count() / 1e6 << " ms, "
+              << elapsed.count() / count << " ns/value"
+              << (count == expected ? "" : " (unexpected count)")
+              << " [sum " << sum << "]\n";
+}
+
+int main()
+{
+    // 2^20 - 1 nodes, one generator per node.
+    std::vector<std::uint32_t> tree((1 << 20) - 1);
+    for (std::size_t i = 0; i < tree.size(); ++i) {
+        tree[i] = static_cast<std::uint32_t>(i);
+    }
+
+    measure("tree walk (std::allocator)", tree.size(),
+            walk<void>(tree, 0));
+    measure("tree walk (coroutine_frame_pool)", tree.size(),
+            walk<iris::coroutine_frame_pool<>>(tree, 0));
+
+    // the cost per value should not depend on the depth of nesting.
+    constexpr std::uint32_t count = 1 << 20;
+    for (std::size_t depth : { 0, 10, 1000, 100000 }) {
+        std::cout << "depth " << depth << ", ";
+        measure("chain", count,
+                chain<iris::coroutine_frame_pool<>>(depth, count));
+    }
+
+    return 0;
+}
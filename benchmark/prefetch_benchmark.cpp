@@ -0,0 +1,75 @@
+#include <iris/ranges/view/prefetch_view.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct alignas(64) line {
+    std::uint64_t values[8];
+};
+
+// the word read from each line depends on the result of the previous read,
+// so the misses are on the critical path: the out-of-order core cannot
+// issue the load of the next line before the current one has arrived. the
+// line itself only depends on the index, which is what a prefetch can use.
+template <typename Range>
+void measure(const char* name, std::size_t count, Range&& lines)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t sum = 0;
+    for (const line& l : lines) {
+        sum = (sum ^ l.values[sum & 7]) * 0xbf58476d1ce4e5b9u;
+        sum ^= sum >> 29;
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << elapsed.count() / 1e6 << " ms, "
+              << elapsed.count() / count << " ns/value [sum " << sum
+              << "]\n";
+}
+
+int main()
+{
+    // a table much larger than the last level cache, gathered in a random
+    // order which the hardware prefetcher cannot predict.
+    std::vector<line> table(std::size_t(1) << 21);
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        for (std::size_t j = 0; j < 8; ++j) {
+            table[i].values[j] = (i * 8 + j) * 2654435761u;
+        }
+    }
+
+    std::vector<std::uint32_t> indices(std::size_t(1) << 22);
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<std::uint32_t> dist(
+        0, static_cast<std::uint32_t>(table.size() - 1));
+    for (auto& i : indices) {
+        i = dist(engine);
+    }
+
+    auto gather = std::views::transform(
+        [&](std::uint32_t i) -> const line& { return table[i]; });
+
+    for (int round = 0; round < 2; ++round) {
+        measure("gather", indices.size(), indices | gather);
+        for (std::ptrdiff_t distance : { 4, 16, 64 }) {
+            std::cout << "distance " << distance << ", ";
+            measure("gather | prefetch", indices.size(),
+                    indices | gather | iris::views::prefetch(distance));
+        }
+        for (std::ptrdiff_t distance : { 4, 16, 64 }) {
+            std::cout << "distance " << distance << ", ";
+            measure("prefetch_by | gather", indices.size(),
+                    indices
+                        | iris::views::prefetch_by(
+                            [&](std::uint32_t i) { return &table[i]; },
+                            distance)
+                        | gather);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)                                      \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IRIS_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define IRIS_HAS_SSE2 0
+#endif
+
+namespace iris::__detail {
+
+// returns a pointer to the first `c` in [`first`, `last`), or `last`.
+// `char_traits::find` is a `memchr` at runtime.
+template <typename CharT>
+constexpr const CharT*
+__find_char(const CharT* first, const CharT* last, CharT c) noexcept
+{
+    if (first == last) {
+        return last;
+    }
+
+    auto found = std::char_traits<CharT>::find(
+        first, static_cast<std::size_t>(last - first), c);
+    return found != nullptr ? found : last;
+}
+
+// returns a pointer to the first occurrence of the non-empty `pattern` in
+// [`first`, `last`), or `last`. candidates are located by their first
+// character with `__find_char`.
+template <typename CharT>
+constexpr const CharT* __find_string(const CharT* first,
+                                     const CharT* last,
+                                     std::basic_string_view<CharT> pattern)
+{
+    IRIS_ASSERT(!pattern.empty());
+    const auto size = static_cast<std::ptrdiff_t>(pattern.size());
+    while (last - first >= size) {
+        first = __find_char(first, last - size + 1, pattern.front());
+        if (first == last - size + 1) {
+            break;
+        }
+        if (std::char_traits<CharT>::compare(first + 1, pattern.data() + 1,
+                                             pattern.size() - 1)
+            == 0) {
+            return first;
+        }
+        ++first;
+    }
+
+    return last;
+}
+
+// a set of single byte characters, which can be searched for all at once.
+template <typename CharT>
+    requires(sizeof(CharT) == 1)
+class __char_set {
+    // the number of characters up to which a search compares each one
+    // against a block of 16 characters, rather than looking up the table.
+    static constexpr std::size_t simd_size_ = 8;
+
+public:
+    __char_set() = default;
+
+    constexpr explicit __char_set(std::basic_string_view<CharT> chars)
+        : chars_(chars)
+    {
+        for (auto c : chars) {
+            const auto u = static_cast<unsigned char>(c);
+            table_[u >> 6] |= std::uint64_t(1) << (u & 63);
+        }
+    }
+
+    constexpr bool contains(CharT c) const noexcept
+    {
+        const auto u = static_cast<unsigned char>(c);
+        return (table_[u >> 6] >> (u & 63)) & 1;
+    }
+
+    // returns a pointer to the first character in [`first`, `last`) which is
+    // in the set, or `last`.
+    constexpr const CharT* find_first_of(const CharT* first,
+                                         const CharT* last) const noexcept
+    {
+        if (chars_.size() == 1) {
+            return __find_char(first, last, chars_.front());
+        }
+
+#if IRIS_HAS_SSE2
+        if (!std::is_constant_evaluated() && !chars_.empty()
+            && chars_.size() <= simd_size_) {
+            first = __find_first_of_simd(first, last);
+        }
+#endif
+
+        for (; first != last; ++first) {
+            if (contains(*first)) {
+                break;
+            }
+        }
+
+        return first;
+    }
+
+private:
+#if IRIS_HAS_SSE2
+    // stops at the first block of 16 characters which contains a character in
+    // the set, or at the last incomplete block.
+    const CharT* __find_first_of_simd(const CharT* first,
+                                      const CharT* last) const noexcept
+    {
+        __m128i needles[simd_size_];
+        for (std::size_t i = 0; i < chars_.size(); ++i) {
+            needles[i] = _mm_set1_epi8(static_cast<char>(chars_[i]));
+        }
+
+        for (; last - first >= 16; first += 16) {
+            const auto block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(first));
+            auto matches = _mm_setzero_si128();
+            for (std::size_t i = 0; i < chars_.size(); ++i) {
+                matches = _mm_or_si128(matches,
+                                       _mm_cmpeq_epi8(block, needles[i]));
+            }
+            if (const auto mask = static_cast<unsigned int>(
+                    _mm_movemask_epi8(matches));
+                mask != 0) {
+                return first + std::countr_zero(mask);
+            }
+        }
+
+        return first;
+    }
+#endif
+
+    std::basic_string<CharT> chars_;
+    std::array<std::uint64_t, 4> table_ {};
+};
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace iris::__detail {
+
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) __default_new_alignment {
+    std::byte d[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+constexpr std::size_t __aligned_allocated_count(std::size_t size)
+{
+    return (size + __STDCPP_DEFAULT_NEW_ALIGNMENT__ - 1)
+        / __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+// allocates coroutine frames with `Allocator`, which is stored right after
+// the frame unless all instances of it compare equal.
+template <typename Allocator>
+class __frame_allocator {
+public:
+    using pointer = typename std::allocator_traits<Allocator>::pointer;
+
+    static constexpr void* allocate(Allocator allocator, std::size_t size)
+    {
+        auto n = __aligned_allocated_count(size);
+        auto a = std::size_t(0);
+        if constexpr (!std::allocator_traits<
+                          Allocator>::is_always_equal::value) {
+            a = __aligned_allocated_count(sizeof(Allocator));
+        }
+
+        auto p = allocator.allocate(n + a);
+
+        if constexpr (!std::allocator_traits<
+                          Allocator>::is_always_equal::value) {
+            std::construct_at(get_allocator(p, n), std::move(allocator));
+        }
+
+        return p;
+    }
+
+    static constexpr void deallocate(void* p, std::size_t size)
+    {
+        auto n = __aligned_allocated_count(size);
+        if constexpr (!std::allocator_traits<
+                          Allocator>::is_always_equal::value) {
+            Allocator allocator = std::move(*get_allocator(p, n));
+            std::destroy_at(get_allocator(p, n));
+            auto a = __aligned_allocated_count(sizeof(Allocator));
+            allocator.deallocate(static_cast<pointer>(p), n + a);
+        } else {
+            Allocator allocator;
+            allocator.deallocate(static_cast<pointer>(p), n);
+        }
+    }
+
+private:
+    static constexpr Allocator* get_allocator(void* p, std::size_t n)
+    {
+        return reinterpret_cast<Allocator*>(static_cast<pointer>(p) + n);
+    }
+};
+
+// allocates coroutine frames with an allocator chosen per frame, for
+// coroutine types which are not parameterized on their allocator. the frame
+// is followed by the function releasing it.
+class __erased_frame_allocator {
+public:
+    template <typename Allocator>
+    static void* allocate(Allocator allocator, std::size_t size)
+    {
+        using BAlloc = typename std::allocator_traits<
+            Allocator>::template rebind_alloc<__default_new_alignment>;
+
+        auto p = __frame_allocator<BAlloc>::allocate(BAlloc(allocator),
+                                                     __extended(size));
+        *__deallocate_function(p, size)
+            = &__frame_allocator<BAlloc>::deallocate;
+        return p;
+    }
+
+    static void deallocate(void* p, std::size_t size)
+    {
+        (*__deallocate_function(p, size))(p, __extended(size));
+    }
+
+private:
+    using __deallocate_type = void (*)(void*, std::size_t);
+
+    static constexpr std::size_t __extended(std::size_t size) noexcept
+    {
+        return __aligned_allocated_count(size)
+            * sizeof(__default_new_alignment)
+            + sizeof(__deallocate_type);
+    }
+
+    static __deallocate_type* __deallocate_function(void* p,
+                                                    std::size_t size) noexcept
+    {
+        return reinterpret_cast<__deallocate_type*>(
+            static_cast<__default_new_alignment*>(p)
+            + __aligned_allocated_count(size));
+    }
+};
+
+}
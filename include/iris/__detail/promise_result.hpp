@@ -0,0 +1,95 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace iris::__detail {
+
+// the outcome of a coroutine, either its return value or the exception
+// escaping its body. both share the same storage so that the frame only
+// grows by the tag, and `T` needs not be default constructible.
+template <typename T>
+class __promise_result {
+public:
+    __promise_result() noexcept { }
+
+    __promise_result(const __promise_result&) = delete;
+
+    __promise_result& operator=(const __promise_result&) = delete;
+
+    ~__promise_result() noexcept
+    {
+        __reset();
+    }
+
+    void return_value(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        __reset();
+        std::construct_at(std::addressof(value_), std::move(value));
+        state_ = __state::value;
+    }
+
+    void unhandled_exception() noexcept
+    {
+        __reset();
+        std::construct_at(std::addressof(exception_),
+                          std::current_exception());
+        state_ = __state::exception;
+    }
+
+    T result()
+    {
+        if (state_ == __state::exception) {
+            std::rethrow_exception(exception_);
+        }
+
+        IRIS_ASSERT(state_ == __state::value);
+        return std::move(value_);
+    }
+
+private:
+    enum class __state : unsigned char { empty, value, exception };
+
+    void __reset() noexcept
+    {
+        if (state_ == __state::value) {
+            std::destroy_at(std::addressof(value_));
+        } else if (state_ == __state::exception) {
+            std::destroy_at(std::addressof(exception_));
+        }
+        state_ = __state::empty;
+    }
+
+    union {
+        T value_;
+        std::exception_ptr exception_;
+    };
+    __state state_ = __state::empty;
+};
+
+template <>
+class __promise_result<void> {
+public:
+    void return_void() noexcept { }
+
+    void unhandled_exception() noexcept
+    {
+        exception_ = std::current_exception();
+    }
+
+    void result()
+    {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::exception_ptr exception_;
+};
+
+}
@@ -2,8 +2,12 @@
 
 #include <iris/config.hpp>
 
-#include <iris/__detail/manual_reset_event.hpp>
+#include <iris/__detail/promise_result.hpp>
 #include <iris/coroutine.hpp>
+#include <iris/run_loop.hpp>
+#if defined(IRIS_ENABLE_TRACING)
+#include <iris/trace.hpp>
+#endif
 
 #include <coroutine>
 #include <type_traits>
@@ -14,59 +18,80 @@ template <typename T>
 class __sync_wait;
 
 template <typename T>
-class __sync_wait_promise_type_base {
+class __sync_wait_promise_type : public __promise_result<T> {
 public:
-    void return_value(T value)
+    __sync_wait_promise_type() noexcept
     {
-        value_ = std::move(value);
+        IRIS_TRACE(create, __frame(), "sync_wait");
     }
 
-    T result()
-    {
-        return std::move(value_);
-    }
-
-private:
-    T value_;
-};
-
-template <>
-class __sync_wait_promise_type_base<void> {
-public:
-    void return_void() noexcept { }
-
-    void result() noexcept { }
-};
-
-template <typename T>
-class __sync_wait_promise_type : public __sync_wait_promise_type_base<T> {
-public:
     __sync_wait<T> get_return_object();
 
     auto initial_suspend() noexcept
     {
+#if defined(IRIS_ENABLE_TRACING)
+        return __traced_initial_suspend("sync_wait");
+#else
         return std::suspend_always();
+#endif
     }
 
     auto final_suspend() noexcept
     {
-        IRIS_ASSERT(event_ != nullptr);
-        event_->set();
-        return std::suspend_always();
+        IRIS_TRACE(complete, __frame(), "sync_wait");
+        IRIS_ASSERT(loop_ != nullptr);
+
+        class awaitable {
+        public:
+            explicit awaitable(run_loop& loop) noexcept
+                : loop_(loop)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            // the waiting thread may destroy the coroutine as soon as the
+            // loop is finished, so it is finished once suspended.
+            void await_suspend(std::coroutine_handle<>) noexcept
+            {
+                loop_.finish();
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            run_loop& loop_;
+        };
+
+        return awaitable(*loop_);
     }
 
-    void unhandled_exception() noexcept
+    void set_loop(run_loop& loop) noexcept
     {
-        std::terminate();
+        loop_ = &loop;
     }
 
-    void set_event(__manual_reset_event& event)
+#if defined(IRIS_ENABLE_TRACING)
+    template <typename Awaitable>
+    auto await_transform(Awaitable&& awaitable)
     {
-        event_ = &event;
+        return __traced_awaitable<Awaitable>(
+            std::forward<Awaitable>(awaitable), "sync_wait");
     }
+#endif
 
 private:
-    __manual_reset_event* event_ = nullptr;
+    void* __frame() noexcept
+    {
+        return std::coroutine_handle<__sync_wait_promise_type>::from_promise(
+                   *this)
+            .address();
+    }
+
+    run_loop* loop_ = nullptr;
 };
 
 template <typename T>
@@ -78,7 +103,7 @@ public:
     using value_type = T;
 
     __sync_wait(__sync_wait&& other) noexcept
-        : handle_(std::exchange(other.handle_))
+        : handle_(std::exchange(other.handle_, {}))
     {
     }
 
@@ -89,13 +114,14 @@ public:
         }
     }
 
-    void start()
+    // starts the coroutine on the calling thread, which then runs `loop`
+    // until the coroutine completes.
+    void start(run_loop& loop)
     {
-        __manual_reset_event event;
-        handle_.promise().set_event(event);
         IRIS_ASSERT(handle_);
+        handle_.promise().set_loop(loop);
         handle_.resume();
-        event.wait();
+        loop.run();
     }
 
     T result()
@@ -119,6 +145,15 @@ __sync_wait_impl(Awaitable&& obj) requires awaitable<Awaitable>
     co_return co_await std::forward<Awaitable>(obj);
 }
 
+template <typename Scheduler, typename Awaitable>
+__sync_wait<awaitable_result_t<Awaitable>>
+__sync_wait_on(Scheduler& scheduler, Awaitable&& obj) requires
+    awaitable<Awaitable>
+{
+    co_await scheduler.schedule();
+    co_return co_await std::forward<Awaitable>(obj);
+}
+
 template <typename T>
 __sync_wait<T> __sync_wait_promise_type<T>::get_return_object()
 {
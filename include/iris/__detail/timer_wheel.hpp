@@ -0,0 +1,255 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace iris::__detail {
+
+struct __timer_node {
+    void (*fire_)(__timer_node*) noexcept = nullptr;
+    std::uint64_t expiry_ = 0;
+    __timer_node* prev_ = nullptr;
+    __timer_node* next_ = nullptr;
+
+    bool linked() const noexcept
+    {
+        return prev_ != nullptr;
+    }
+};
+
+// hashed hierarchical timer wheel with 4 levels of 256 slots. a slot of
+// level `k` spans 256^k ticks. timers are intrusive nodes in doubly linked
+// slot lists, so that insertion and cancellation are O(1). timers of a
+// higher level are cascaded to the lower levels as time passes, and a
+// bitmap of occupied slots lets `advance()` skip idle ticks.
+class __timer_wheel {
+public:
+    static constexpr std::size_t level_count = 4;
+    static constexpr std::size_t slot_bits = 8;
+    static constexpr std::size_t slot_count = std::size_t(1) << slot_bits;
+    static constexpr std::uint64_t slot_mask = slot_count - 1;
+
+    __timer_wheel() noexcept
+    {
+        for (auto& level : slots_) {
+            for (auto& head : level) {
+                head.prev_ = head.next_ = &head;
+            }
+        }
+    }
+
+    __timer_wheel(const __timer_wheel&) = delete;
+
+    __timer_wheel& operator=(const __timer_wheel&) = delete;
+
+    std::uint64_t now() const noexcept
+    {
+        return current_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // schedules `node` to fire on `advance()` to `expiry` or later. timers
+    // that are already due fire on the next tick.
+    void insert(__timer_node& node, std::uint64_t expiry) noexcept
+    {
+        IRIS_ASSERT(!node.linked());
+        node.expiry_ = expiry > current_ ? expiry : current_ + 1;
+        __link(node);
+        ++size_;
+    }
+
+    void cancel(__timer_node& node) noexcept
+    {
+        IRIS_ASSERT(node.linked());
+        __unlink(node);
+        --size_;
+    }
+
+    // returns the earliest tick at which `advance()` may have something to
+    // do, or `max()` if there are no timers.
+    std::uint64_t next_tick() const noexcept
+    {
+        if (size_ == 0) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+
+        auto index = (current_ & slot_mask) + 1;
+        if (index < slot_count) {
+            if (auto next = __find_occupied(0, index); next < slot_count) {
+                return (current_ & ~slot_mask) + next;
+            }
+        }
+
+        // nothing is due in this rotation, wake up for the cascade.
+        return (current_ | slot_mask) + 1;
+    }
+
+    // fires all timers with an expiry up to `tick`, returns the number of
+    // timers fired.
+    std::size_t advance(std::uint64_t tick) noexcept
+    {
+        std::size_t fired = 0;
+        while (current_ < tick) {
+            auto next = next_tick();
+            if (next > tick) {
+                current_ = tick;
+                break;
+            }
+
+            current_ = next;
+            __cascade();
+            fired += __expire(slots_[0][current_ & slot_mask]);
+        }
+
+        return fired;
+    }
+
+private:
+    void __link(__timer_node& node) noexcept
+    {
+        constexpr auto span = std::uint64_t(1) << (slot_bits * level_count);
+
+        // timers beyond the span of the wheel are parked in the farthest
+        // slot, and relinked with their real expiry when it is cascaded.
+        auto expiry = node.expiry_;
+        auto delta = expiry - current_;
+        if (delta >= span) {
+            delta = span - 1;
+            expiry = current_ + delta;
+        }
+
+        std::size_t level = 0;
+        while (level + 1 < level_count
+               && delta >= (std::uint64_t(1) << (slot_bits * (level + 1)))) {
+            ++level;
+        }
+
+        auto index = (expiry >> (slot_bits * level)) & slot_mask;
+        auto& head = slots_[level][index];
+        node.prev_ = head.prev_;
+        node.next_ = &head;
+        head.prev_->next_ = &node;
+        head.prev_ = &node;
+        occupied_[level][index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+
+    void __clear_occupied(std::size_t level, std::size_t index) noexcept
+    {
+        occupied_[level][index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    }
+
+    void __unlink(__timer_node& node) noexcept
+    {
+        node.prev_->next_ = node.next_;
+        node.next_->prev_ = node.prev_;
+
+        // the slot becomes empty if only its self-linked head is left.
+        auto* head = node.next_;
+        if (head == node.prev_ && head->next_ == head) {
+            auto [level, index] = __slot_of(head);
+            __clear_occupied(level, index);
+        }
+
+        node.prev_ = node.next_ = nullptr;
+    }
+
+    struct __slot_position {
+        std::size_t level;
+        std::size_t index;
+    };
+
+    __slot_position __slot_of(const __timer_node* head) const noexcept
+    {
+        auto offset = head - &slots_[0][0];
+        IRIS_ASSERT(offset >= 0
+                    && offset < static_cast<std::ptrdiff_t>(level_count
+                                                            * slot_count));
+        return { static_cast<std::size_t>(offset) / slot_count,
+                 static_cast<std::size_t>(offset) % slot_count };
+    }
+
+    std::size_t __find_occupied(std::size_t level,
+                                std::size_t from) const noexcept
+    {
+        for (auto word = from / 64; word < slot_count / 64; ++word) {
+            auto bits = occupied_[level][word];
+            if (word == from / 64) {
+                bits &= ~std::uint64_t(0) << (from % 64);
+            }
+            if (bits != 0) {
+                return word * 64
+                    + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+        }
+
+        return slot_count;
+    }
+
+    // moves the timers of the higher level slots that start at `current_`
+    // down to the lower levels.
+    void __cascade() noexcept
+    {
+        std::size_t level = 0;
+        while (level + 1 < level_count
+               && (current_
+                   & ((std::uint64_t(1) << (slot_bits * (level + 1))) - 1))
+                   == 0) {
+            ++level;
+        }
+
+        for (; level > 0; --level) {
+            auto index = (current_ >> (slot_bits * level)) & slot_mask;
+            auto& head = slots_[level][index];
+            if (head.next_ == &head) {
+                continue;
+            }
+
+            // detach the list before relinking, as timers may land in the
+            // same slot again when they are still far away.
+            auto* node = head.next_;
+            head.prev_->next_ = nullptr;
+            head.prev_ = head.next_ = &head;
+            __clear_occupied(level, index);
+
+            while (node != nullptr) {
+                auto* next = node->next_;
+                __link(*node);
+                node = next;
+            }
+        }
+    }
+
+    std::size_t __expire(__timer_node& head) noexcept
+    {
+        std::size_t fired = 0;
+        while (head.next_ != &head) {
+            auto* node = head.next_;
+            __unlink(*node);
+            --size_;
+            ++fired;
+            node->fire_(node);
+        }
+
+        return fired;
+    }
+
+    __timer_node slots_[level_count][slot_count];
+    std::uint64_t occupied_[level_count][slot_count / 64] = {};
+    std::uint64_t current_ = 0;
+    std::size_t size_ = 0;
+};
+
+}
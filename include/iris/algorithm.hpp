@@ -7,5 +7,6 @@
 #include <iris/ranges/algorithm/find_last.hpp>
 #include <iris/ranges/algorithm/fold.hpp>
 #include <iris/ranges/algorithm/iota.hpp>
+#include <iris/ranges/algorithm/parallel.hpp>
 #include <iris/ranges/algorithm/shift.hpp>
 #include <iris/ranges/algorithm/starts_with.hpp>
@@ -3,16 +3,32 @@
 #include <iris/config.hpp>
 
 #include <iris/algorithm.hpp>
+#include <iris/async_barrier.hpp>
+#include <iris/async_file.hpp>
+#include <iris/async_generator.hpp>
+#include <iris/async_latch.hpp>
+#include <iris/async_mutex.hpp>
+#include <iris/async_scope.hpp>
+#include <iris/async_semaphore.hpp>
 #include <iris/base64.hpp>
 #include <iris/bind.hpp>
+#include <iris/channel.hpp>
 #include <iris/coroutine.hpp>
+#include <iris/coroutine_frame_pool.hpp>
 #include <iris/expected.hpp>
 #include <iris/generator.hpp>
+#include <iris/io_context.hpp>
 #include <iris/lazy.hpp>
 #include <iris/out_ptr.hpp>
 #include <iris/ranges.hpp>
+#include <iris/run_loop.hpp>
 #include <iris/scope.hpp>
+#include <iris/shared_lazy.hpp>
+#include <iris/sync_wait.hpp>
 #include <iris/system.hpp>
+#include <iris/thread_pool.hpp>
+#include <iris/timeout.hpp>
+#include <iris/trace.hpp>
 #include <iris/type_traits.hpp>
 #include <iris/utf.hpp>
 #include <iris/utility.hpp>
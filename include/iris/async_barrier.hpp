@@ -0,0 +1,115 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace iris {
+
+// a reusable barrier for coroutines. each phase completes once the expected
+// number of participants has arrived, at which point the last arriving
+// coroutine resumes the others inline and continues without suspending.
+class async_barrier {
+public:
+    explicit async_barrier(std::ptrdiff_t expected) noexcept
+        : expected_(expected)
+        , remaining_(expected)
+    {
+        IRIS_ASSERT(expected > 0);
+    }
+
+    async_barrier(const async_barrier&) = delete;
+
+    async_barrier& operator=(const async_barrier&) = delete;
+
+    ~async_barrier() noexcept
+    {
+        IRIS_ASSERT(waiters_ == nullptr);
+    }
+
+    // arrives at the barrier and waits for the current phase to complete.
+    auto arrive_and_wait() noexcept
+    {
+        class awaitable : public __node {
+        public:
+            explicit awaitable(async_barrier& barrier) noexcept
+                : barrier_(barrier)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                return barrier_.__arrive(this, false);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            async_barrier& barrier_;
+        };
+
+        return awaitable(*this);
+    }
+
+    // arrives at the barrier and leaves it, reducing the number of
+    // participants of the following phases by one.
+    void arrive_and_drop() noexcept
+    {
+        __arrive(nullptr, true);
+    }
+
+private:
+    struct __node {
+        std::coroutine_handle<> handle_;
+        __node* next_ = nullptr;
+    };
+
+    // returns true if `node` has been enqueued to wait for the phase to
+    // complete.
+    bool __arrive(__node* node, bool drop) noexcept
+    {
+        __node* waiters = nullptr;
+        {
+            std::unique_lock lock(mutex_);
+            if (drop) {
+                --expected_;
+            }
+
+            IRIS_ASSERT(remaining_ > 0);
+            if (--remaining_ > 0) {
+                if (node != nullptr) {
+                    node->next_ = waiters_;
+                    waiters_ = node;
+                }
+                return node != nullptr;
+            }
+
+            remaining_ = expected_;
+            waiters = std::exchange(waiters_, nullptr);
+        }
+
+        while (waiters != nullptr) {
+            auto* next = waiters->next_;
+            waiters->handle_.resume();
+            waiters = next;
+        }
+
+        return false;
+    }
+
+    std::mutex mutex_;
+    std::ptrdiff_t expected_;
+    std::ptrdiff_t remaining_;
+    __node* waiters_ = nullptr;
+};
+
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#if defined(__linux__)
+
+#include <iris/expected.hpp>
+#include <iris/io_context.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace iris {
+
+class async_file;
+class file_service;
+
+namespace __io_detail {
+    struct __file_operation : __operation {
+        enum class __opcode : std::uint8_t { read, write };
+
+        __opcode opcode_ = __opcode::read;
+        int fd_ = -1;
+        int buffer_index_ = -1;
+        int error_ = 0;
+        std::uint64_t offset_ = 0;
+        std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t result_ = 0;
+        io_context* context_ = nullptr;
+        file_service* service_ = nullptr;
+    };
+
+    struct __uring;
+    struct __thread_pool;
+}
+
+enum class file_backend {
+    io_uring,
+    thread_pool,
+};
+
+enum class file_mode {
+    read,
+    write,
+    read_write,
+};
+
+// executes file operations for coroutines running on an `io_context`.
+//
+// with the io_uring backend, submissions are queued in the submission ring
+// and handed to the kernel in one batch per event loop iteration, and
+// completions are reaped through an eventfd registered with the
+// io_context. the ring is only touched by the thread running the
+// io_context, operations awaited elsewhere are posted to it first. the
+// thread pool backend performs blocking `pread`/`pwrite` on worker threads
+// and resumes awaiters on the io_context.
+class file_service {
+public:
+    // uses io_uring if it is available, the thread pool otherwise.
+    explicit file_service(io_context& context, unsigned entries = 128);
+
+    file_service(io_context& context,
+                 file_backend backend,
+                 unsigned entries = 128);
+
+    file_service(const file_service&) = delete;
+
+    file_service& operator=(const file_service&) = delete;
+
+    ~file_service() noexcept;
+
+    file_backend backend() const noexcept
+    {
+        return uring_ ? file_backend::io_uring : file_backend::thread_pool;
+    }
+
+    io_context& context() const noexcept
+    {
+        return context_;
+    }
+
+    // registers `buffers` with the kernel so that reads and writes passing a
+    // buffer index skip per-operation page pinning. replaces previously
+    // registered buffers. a no-op with the thread pool backend.
+    expected<void, std::error_code>
+    register_buffers(std::span<const std::span<std::byte>> buffers);
+
+    void unregister_buffers() noexcept;
+
+    void submit(__io_detail::__file_operation& op) noexcept;
+
+private:
+    io_context& context_;
+    std::unique_ptr<__io_detail::__uring> uring_;
+    std::unique_ptr<__io_detail::__thread_pool> pool_;
+};
+
+class async_file {
+public:
+    async_file(const async_file&) = delete;
+
+    async_file(async_file&& other) noexcept
+        : service_(other.service_)
+        , fd_(std::exchange(other.fd_, -1))
+    {
+    }
+
+    async_file& operator=(const async_file&) = delete;
+
+    async_file& operator=(async_file&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            service_ = other.service_;
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    ~async_file() noexcept
+    {
+        close();
+    }
+
+    static expected<async_file, std::error_code>
+    open(file_service& service,
+         const std::filesystem::path& path,
+         file_mode mode = file_mode::read);
+
+    void close() noexcept;
+
+    bool is_open() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    int native_handle() const noexcept
+    {
+        return fd_;
+    }
+
+    expected<std::uint64_t, std::error_code> size() const noexcept;
+
+    // `buffer_index` refers to a buffer passed to
+    // `file_service::register_buffers()` which contains `buffer`.
+    auto async_read_at(std::uint64_t offset,
+                       std::span<std::byte> buffer,
+                       int buffer_index = -1) noexcept
+    {
+        return awaitable(*service_, fd_,
+                         __io_detail::__file_operation::__opcode::read, offset,
+                         buffer.data(), buffer.size(), buffer_index);
+    }
+
+    auto async_write_at(std::uint64_t offset,
+                        std::span<const std::byte> buffer,
+                        int buffer_index = -1) noexcept
+    {
+        return awaitable(*service_, fd_,
+                         __io_detail::__file_operation::__opcode::write,
+                         offset, const_cast<std::byte*>(buffer.data()),
+                         buffer.size(), buffer_index);
+    }
+
+private:
+    class awaitable : private __io_detail::__file_operation {
+    public:
+        awaitable(file_service& service,
+                  int fd,
+                  __opcode opcode,
+                  std::uint64_t offset,
+                  std::byte* data,
+                  std::size_t size,
+                  int buffer_index) noexcept
+        {
+            opcode_ = opcode;
+            fd_ = fd;
+            buffer_index_ = buffer_index;
+            offset_ = offset;
+            data_ = data;
+            size_ = size;
+            context_ = &service.context();
+            service_ = &service;
+        }
+
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            handle_ = handle;
+            service_->submit(*this);
+        }
+
+        expected<std::size_t, std::error_code> await_resume() const noexcept
+        {
+            if (error_ != 0) {
+                return unexpected(
+                    std::error_code(error_, std::generic_category()));
+            }
+
+            return result_;
+        }
+    };
+
+    async_file(file_service& service, int fd) noexcept
+        : service_(&service)
+        , fd_(fd)
+    {
+    }
+
+    file_service* service_;
+    int fd_ = -1;
+};
+
+}
+
+#endif
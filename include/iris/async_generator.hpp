@@ -0,0 +1,398 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/elements_of.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace iris {
+
+template <typename R, typename V = void>
+class [[nodiscard]] async_generator {
+public:
+    using value
+        = std::conditional_t<std::is_void_v<V>, std::remove_cvref_t<R>, V>;
+    using reference = std::conditional_t<std::is_void_v<V>, R&&, R>;
+    using yielded = std::conditional_t<std::is_reference_v<reference>,
+                                       reference,
+                                       const reference&>;
+
+    // clang-format off
+    static_assert(!std::is_const_v<value> && !std::is_reference_v<value>);
+    static_assert(std::is_reference_v<reference>
+        || (!std::is_const_v<reference>
+            && !std::is_reference_v<reference>
+            && std::is_copy_constructible_v<reference>));
+    // clang-format on
+
+    class promise_type;
+    class iterator;
+
+    class promise_type {
+        friend class async_generator;
+        friend class iterator;
+
+    public:
+        promise_type()
+            : root_(std::coroutine_handle<promise_type>::from_promise(*this))
+        {
+        }
+
+        async_generator get_return_object() noexcept;
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_always();
+        }
+
+        auto final_suspend() noexcept
+        {
+            class awaitable {
+            public:
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    // leaf coroutine is done, return control to parent
+                    // coroutine.
+                    if (promise.parent_) {
+                        promise.root_.promise().root_ = promise.parent_;
+                        return promise.parent_;
+                    }
+
+                    return promise.consumer_;
+                }
+
+                void await_resume() noexcept { }
+            };
+
+            return awaitable {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            root_.promise().exception_ = std::current_exception();
+        }
+
+        class yield_awaitable {
+        public:
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                return handle.promise().root_.promise().consumer_;
+            }
+
+            void await_resume() noexcept { }
+        };
+
+        auto yield_value(yielded value) noexcept
+        {
+            root_.promise().set_value(&value);
+            return yield_awaitable {};
+        }
+
+        class yield_lvalue_awaitable {
+            friend class promise_type;
+
+        public:
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                auto& root_promise = handle.promise().root_.promise();
+                root_promise.set_value(&value_);
+                return root_promise.consumer_;
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            yield_lvalue_awaitable(
+                std::remove_cv_t<std::remove_reference_t<yielded>> value)
+                : value_(value)
+            {
+            }
+
+            std::remove_cv_t<std::remove_reference_t<yielded>> value_;
+        };
+
+        // clang-format off
+        template <typename Yielded = std::remove_reference_t<yielded>>
+        auto yield_value(const std::type_identity_t<Yielded>& lvalue) noexcept
+            requires std::is_rvalue_reference_v<yielded>
+                && std::constructible_from<std::remove_cvref_t<yielded>, const Yielded&>
+        // clang-format on
+        {
+            return yield_lvalue_awaitable { lvalue };
+        }
+
+        class yield_generator_awaitable {
+            friend class promise_type;
+
+        public:
+            bool await_ready() noexcept
+            {
+                return !child_.handle_;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                auto& child_promise = child_.handle_.promise();
+
+                // child coroutine should yield value to root coroutine.
+                child_promise.root_ = handle.promise().root_;
+
+                // should resume child coroutine when try to resume the
+                // root coroutine.
+                handle.promise().root_.promise().root_ = child_.handle_;
+
+                // store this coroutine as parent of child coroutine.
+                child_promise.parent_ = handle;
+
+                return child_.handle_;
+            }
+
+            void await_resume()
+            {
+                if (!child_.handle_) {
+                    return;
+                }
+
+                auto& root_promise = child_.handle_.promise().root_.promise();
+                if (root_promise.exception_) {
+                    std::rethrow_exception(
+                        std::exchange(root_promise.exception_, {}));
+                }
+            }
+
+        private:
+            yield_generator_awaitable(async_generator child)
+                : child_(std::move(child))
+            {
+            }
+
+            async_generator child_;
+        };
+
+        template <typename Unused>
+        auto yield_value(
+            ranges::elements_of<async_generator&&, Unused> range) noexcept
+        {
+            return yield_generator_awaitable(std::move(range.range));
+        }
+
+        template <std::ranges::input_range Range, typename Allocator>
+        auto yield_value(
+            ranges::elements_of<Range, Allocator> range) noexcept requires
+            std::convertible_to<std::ranges::range_reference_t<Range>, yielded>
+        {
+            auto nested = [](auto* range) -> async_generator {
+                for (auto&& element : *range)
+                    co_yield static_cast<yielded>(
+                        std::forward<decltype(element)>(element));
+            };
+
+            return yield_value(ranges::elements_of(nested(&range.range)));
+        }
+
+        void return_void() noexcept { }
+
+        void set_value(std::add_pointer_t<yielded> value) noexcept
+        {
+            value_ = value;
+        }
+
+    private:
+        // resumes the innermost active coroutine on behalf of `consumer`.
+        std::coroutine_handle<> resume(std::coroutine_handle<> consumer)
+        {
+            consumer_ = consumer;
+            return root_;
+        }
+
+        void rethrow_if_exception()
+        {
+            if (exception_) {
+                std::rethrow_exception(std::exchange(exception_, {}));
+            }
+        }
+
+        std::add_pointer_t<yielded> value_ = nullptr;
+        std::exception_ptr exception_;
+        std::coroutine_handle<> consumer_;
+        std::coroutine_handle<promise_type> root_;
+        std::coroutine_handle<promise_type> parent_;
+    };
+
+    class iterator {
+        friend class async_generator;
+
+    public:
+        using value_type = value;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(iterator&& other) noexcept
+            : handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        iterator& operator=(iterator&& other) noexcept
+        {
+            handle_ = std::exchange(other.handle_, {});
+            return *this;
+        }
+
+        [[nodiscard]] reference operator*() const
+            noexcept(std::is_nothrow_copy_constructible_v<reference>)
+        {
+            IRIS_ASSERT(handle_ && !handle_.done());
+            return static_cast<reference>(*handle_.promise().value_);
+        }
+
+        [[nodiscard]] auto operator++() noexcept
+        {
+            class awaitable {
+            public:
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<> handle) noexcept
+                {
+                    return iter_.handle_.promise().resume(handle);
+                }
+
+                iterator& await_resume()
+                {
+                    iter_.handle_.promise().rethrow_if_exception();
+                    return iter_;
+                }
+
+                iterator& iter_;
+            };
+
+            IRIS_ASSERT(handle_ && !handle_.done());
+            return awaitable { *this };
+        }
+
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+        {
+            return !handle_ || handle_.done();
+        }
+
+    private:
+        explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+            : handle_(handle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    async_generator(const async_generator&) = delete;
+
+    async_generator(async_generator&& other) noexcept
+        : handle_(std::exchange(other.handle_, {}))
+    {
+    }
+
+    ~async_generator()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    async_generator& operator=(const async_generator&) = delete;
+
+    async_generator& operator=(async_generator&& other) noexcept
+    {
+        if (auto old
+            = std::exchange(handle_, std::exchange(other.handle_, {}))) {
+            old.destroy();
+        }
+        return *this;
+    }
+
+    [[nodiscard]] auto begin() noexcept
+    {
+        class awaitable {
+        public:
+            bool await_ready() noexcept
+            {
+                return !handle_;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                return handle_.promise().resume(handle);
+            }
+
+            iterator await_resume()
+            {
+                if (handle_) {
+                    handle_.promise().rethrow_if_exception();
+                }
+                return iterator { handle_ };
+            }
+
+            std::coroutine_handle<promise_type> handle_;
+        };
+
+        return awaitable { handle_ };
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() noexcept
+    {
+        return {};
+    }
+
+private:
+    explicit async_generator(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename R, typename V>
+async_generator<R, V>
+async_generator<R, V>::promise_type::get_return_object() noexcept
+{
+    return async_generator { std::coroutine_handle<promise_type>::from_promise(
+        *this) };
+}
+
+namespace __detail {
+    template <typename R, typename V>
+    inline constexpr bool __enable_elements_of<async_generator<R, V>> = true;
+}
+
+}
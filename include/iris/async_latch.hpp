@@ -0,0 +1,144 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+
+namespace iris {
+
+// a single-use counter which resumes all awaiting coroutines once it has
+// been counted down to zero. waiters are kept in a lock-free stack and are
+// resumed inline by the final `count_down()`.
+class async_latch {
+    class __wait_awaitable_base {
+        friend class async_latch;
+
+    public:
+        explicit __wait_awaitable_base(async_latch& latch) noexcept
+            : latch_(latch)
+        {
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            handle_ = handle;
+            return latch_.__enqueue(*this);
+        }
+
+        void await_resume() noexcept { }
+
+    protected:
+        async_latch& latch_;
+
+    private:
+        std::coroutine_handle<> handle_;
+        __wait_awaitable_base* next_ = nullptr;
+    };
+
+public:
+    explicit async_latch(std::ptrdiff_t expected) noexcept
+        : count_(expected)
+        , state_(expected > 0 ? nullptr : __ready())
+    {
+        IRIS_ASSERT(expected >= 0);
+    }
+
+    async_latch(const async_latch&) = delete;
+
+    async_latch& operator=(const async_latch&) = delete;
+
+    void count_down(std::ptrdiff_t update = 1) noexcept
+    {
+        IRIS_ASSERT(update >= 0);
+        auto count = count_.fetch_sub(update, std::memory_order_acq_rel);
+        IRIS_ASSERT(count >= update);
+        if (count != update) {
+            return;
+        }
+
+        auto* node = static_cast<__wait_awaitable_base*>(
+            state_.exchange(__ready(), std::memory_order_acq_rel));
+        while (node != nullptr) {
+            // a resumed waiter may destroy the latch.
+            auto* next = node->next_;
+            node->handle_.resume();
+            node = next;
+        }
+    }
+
+    bool try_wait() const noexcept
+    {
+        return state_.load(std::memory_order_acquire) == __ready();
+    }
+
+    auto wait() noexcept
+    {
+        class awaitable : public __wait_awaitable_base {
+        public:
+            using __wait_awaitable_base::__wait_awaitable_base;
+
+            bool await_ready() noexcept
+            {
+                return latch_.try_wait();
+            }
+        };
+
+        return awaitable(*this);
+    }
+
+    // counts down by `update` and waits until the counter reaches zero.
+    auto arrive_and_wait(std::ptrdiff_t update = 1) noexcept
+    {
+        class awaitable : public __wait_awaitable_base {
+        public:
+            awaitable(async_latch& latch, std::ptrdiff_t update) noexcept
+                : __wait_awaitable_base(latch)
+                , update_(update)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                latch_.count_down(update_);
+                return latch_.try_wait();
+            }
+
+        private:
+            std::ptrdiff_t update_;
+        };
+
+        return awaitable(*this, update);
+    }
+
+private:
+    // returns false if the latch is ready.
+    bool __enqueue(__wait_awaitable_base& awaitable) noexcept
+    {
+        auto state = state_.load(std::memory_order_acquire);
+        do {
+            if (state == __ready()) {
+                return false;
+            }
+
+            awaitable.next_ = static_cast<__wait_awaitable_base*>(state);
+        } while (!state_.compare_exchange_weak(state, &awaitable,
+                                               std::memory_order_release,
+                                               std::memory_order_acquire));
+
+        return true;
+    }
+
+    void* __ready() const noexcept
+    {
+        return const_cast<async_latch*>(this);
+    }
+
+    std::atomic<std::ptrdiff_t> count_;
+    // `this` once the counter reached zero, otherwise the head of the stack
+    // of waiters.
+    std::atomic<void*> state_;
+};
+
+}
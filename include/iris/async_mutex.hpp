@@ -0,0 +1,195 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <utility>
+
+namespace iris {
+
+class async_mutex;
+
+// owns a lock of an `async_mutex` and unlocks it on destruction.
+class async_mutex_lock {
+public:
+    async_mutex_lock(async_mutex& mutex, std::adopt_lock_t) noexcept
+        : mutex_(&mutex)
+    {
+    }
+
+    async_mutex_lock(const async_mutex_lock&) = delete;
+
+    async_mutex_lock(async_mutex_lock&& other) noexcept
+        : mutex_(std::exchange(other.mutex_, nullptr))
+    {
+    }
+
+    async_mutex_lock& operator=(const async_mutex_lock&) = delete;
+
+    async_mutex_lock& operator=(async_mutex_lock&&) = delete;
+
+    ~async_mutex_lock() noexcept;
+
+private:
+    async_mutex* mutex_;
+};
+
+// a mutex whose `lock()` suspends the awaiting coroutine instead of blocking
+// the thread. waiters push themselves onto a lock-free stack, which the
+// owner reverses into a FIFO queue on `unlock()`. the lock is handed
+// directly to the oldest waiter, which is resumed inline by `unlock()`.
+class async_mutex {
+    class __lock_awaitable_base {
+        friend class async_mutex;
+
+    public:
+        explicit __lock_awaitable_base(async_mutex& mutex) noexcept
+            : mutex_(mutex)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return mutex_.try_lock();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            handle_ = handle;
+            return mutex_.__enqueue(*this);
+        }
+
+    protected:
+        async_mutex& mutex_;
+
+    private:
+        std::coroutine_handle<> handle_;
+        __lock_awaitable_base* next_ = nullptr;
+    };
+
+public:
+    async_mutex() noexcept = default;
+
+    async_mutex(const async_mutex&) = delete;
+
+    async_mutex& operator=(const async_mutex&) = delete;
+
+    ~async_mutex() noexcept
+    {
+        IRIS_ASSERT(state_.load(std::memory_order_relaxed) == __not_locked());
+    }
+
+    bool try_lock() noexcept
+    {
+        void* state = __not_locked();
+        return state_.compare_exchange_strong(state, nullptr,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    // `co_await mutex.lock()` acquires the lock, which must be released by
+    // `unlock()`.
+    auto lock() noexcept
+    {
+        class awaitable : public __lock_awaitable_base {
+        public:
+            using __lock_awaitable_base::__lock_awaitable_base;
+
+            void await_resume() noexcept { }
+        };
+
+        return awaitable(*this);
+    }
+
+    // `co_await mutex.scoped_lock()` acquires the lock and returns an
+    // `async_mutex_lock` owning it.
+    auto scoped_lock() noexcept
+    {
+        class awaitable : public __lock_awaitable_base {
+        public:
+            using __lock_awaitable_base::__lock_awaitable_base;
+
+            [[nodiscard]] async_mutex_lock await_resume() noexcept
+            {
+                return async_mutex_lock(mutex_, std::adopt_lock);
+            }
+        };
+
+        return awaitable(*this);
+    }
+
+    void unlock() noexcept
+    {
+        IRIS_ASSERT(state_.load(std::memory_order_relaxed) != __not_locked());
+
+        auto* waiter = waiters_;
+        if (waiter == nullptr) {
+            void* state = nullptr;
+            if (state_.compare_exchange_strong(state, __not_locked(),
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+                return;
+            }
+
+            // new waiters arrived, take them all and restore them to arrival
+            // order.
+            auto* node = static_cast<__lock_awaitable_base*>(
+                state_.exchange(nullptr, std::memory_order_acquire));
+            while (node != nullptr) {
+                auto* next = node->next_;
+                node->next_ = waiter;
+                waiter = node;
+                node = next;
+            }
+        }
+
+        waiters_ = waiter->next_;
+        waiter->handle_.resume();
+    }
+
+private:
+    // returns false if the lock has been acquired without suspending.
+    bool __enqueue(__lock_awaitable_base& awaitable) noexcept
+    {
+        auto state = state_.load(std::memory_order_relaxed);
+        while (true) {
+            if (state == __not_locked()) {
+                if (state_.compare_exchange_weak(state, nullptr,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return false;
+                }
+                continue;
+            }
+
+            awaitable.next_ = static_cast<__lock_awaitable_base*>(state);
+            if (state_.compare_exchange_weak(state, &awaitable,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    void* __not_locked() const noexcept
+    {
+        return const_cast<async_mutex*>(this);
+    }
+
+    // `this` if not locked, `nullptr` if locked without new waiters,
+    // otherwise the head of the stack of new waiters.
+    std::atomic<void*> state_ { __not_locked() };
+    // waiters in FIFO order, only accessed by the owner of the lock.
+    __lock_awaitable_base* waiters_ = nullptr;
+};
+
+inline async_mutex_lock::~async_mutex_lock() noexcept
+{
+    if (mutex_ != nullptr) {
+        mutex_->unlock();
+    }
+}
+
+}
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/lazy.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace iris {
+
+class async_scope;
+
+namespace __async_scope_detail {
+    // caches freed frames of spawned tasks by size class so that spawning
+    // in a steady state does not allocate. at most `max_cached` frames are
+    // kept per size class.
+    class __frame_pool {
+    public:
+        static constexpr std::size_t granularity = 64;
+        static constexpr std::size_t class_count = 16;
+        static constexpr std::size_t max_cached = 64;
+
+        __frame_pool() = default;
+
+        __frame_pool(const __frame_pool&) = delete;
+
+        __frame_pool& operator=(const __frame_pool&) = delete;
+
+        ~__frame_pool() noexcept
+        {
+            for (auto& list : free_) {
+                while (list.head_ != nullptr) {
+                    ::operator delete(std::exchange(list.head_,
+                                                    list.head_->next_));
+                }
+            }
+        }
+
+        void* allocate(std::size_t size)
+        {
+            auto index = __class_of(size);
+            if (index < class_count) {
+                std::unique_lock lock(mutex_);
+                auto& list = free_[index];
+                if (list.head_ != nullptr) {
+                    --list.size_;
+                    return std::exchange(list.head_, list.head_->next_);
+                }
+            }
+
+            return ::operator new(__block_size(size));
+        }
+
+        void deallocate(void* pointer, std::size_t size) noexcept
+        {
+            auto index = __class_of(size);
+            if (index < class_count) {
+                std::unique_lock lock(mutex_);
+                auto& list = free_[index];
+                if (list.size_ < max_cached) {
+                    auto* block = static_cast<__block*>(pointer);
+                    block->next_ = list.head_;
+                    list.head_ = block;
+                    ++list.size_;
+                    return;
+                }
+            }
+
+            ::operator delete(pointer);
+        }
+
+    private:
+        struct __block {
+            __block* next_;
+        };
+
+        struct __list {
+            __block* head_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        static std::size_t __class_of(std::size_t size) noexcept
+        {
+            return (size - 1) / granularity;
+        }
+
+        static std::size_t __block_size(std::size_t size) noexcept
+        {
+            return __class_of(size) < class_count
+                ? (__class_of(size) + 1) * granularity
+                : size;
+        }
+
+        std::mutex mutex_;
+        __list free_[class_count];
+    };
+
+    class __spawned {
+    public:
+        class promise_type {
+        public:
+            // the frame is prefixed by the pool it is allocated from, as
+            // `operator delete` cannot see the arguments of the coroutine.
+            static constexpr std::size_t header_size
+                = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+            template <typename... Args>
+            static void*
+            operator new(std::size_t size, async_scope& scope, Args&...);
+
+            static void operator delete(void* pointer, std::size_t size)
+            {
+                auto* block = static_cast<std::byte*>(pointer) - header_size;
+                auto* pool = *reinterpret_cast<__frame_pool**>(block);
+                pool->deallocate(block, size + header_size);
+            }
+
+            // the reference of the task is taken once its frame has been
+            // allocated, so that a failed allocation leaves the scope as it
+            // was.
+            template <typename... Args>
+            promise_type(async_scope& scope, Args&...) noexcept;
+
+            __spawned get_return_object() noexcept
+            {
+                return {};
+            }
+
+            auto initial_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            auto final_suspend() noexcept
+            {
+                class awaitable {
+                public:
+                    bool await_ready() noexcept
+                    {
+                        return false;
+                    }
+
+                    void await_suspend(
+                        std::coroutine_handle<promise_type> handle) noexcept
+                    {
+                        // the frame must go back to the pool before the
+                        // scope is released, as the joiner may destroy the
+                        // scope.
+                        auto* scope = handle.promise().scope_;
+                        handle.destroy();
+                        __complete(scope);
+                    }
+
+                    void await_resume() noexcept { }
+                };
+
+                return awaitable {};
+            }
+
+            void return_void() noexcept { }
+
+            void unhandled_exception() noexcept
+            {
+                __fail(scope_, std::current_exception());
+            }
+
+        private:
+            static void __complete(async_scope* scope) noexcept;
+
+            static void __fail(async_scope* scope,
+                               std::exception_ptr exception) noexcept;
+
+            async_scope* scope_;
+        };
+    };
+}
+
+// owns detached tasks. `spawn()` starts a `lazy<void>` without awaiting it,
+// and `join()` waits until all spawned tasks have completed, and rethrows
+// the first exception which escaped one of them. the frames of
+// the coroutines driving spawned tasks are recycled through a pool owned by
+// the scope. a scope must be joined before it is destroyed.
+class async_scope {
+    friend class __async_scope_detail::__spawned::promise_type;
+
+public:
+    async_scope() noexcept = default;
+
+    async_scope(const async_scope&) = delete;
+
+    async_scope& operator=(const async_scope&) = delete;
+
+    ~async_scope() noexcept
+    {
+        IRIS_ASSERT(count_.load(std::memory_order_acquire) == 1);
+    }
+
+    // starts `task` on the calling thread. if `task` throws, the exception
+    // is rethrown by the next `join()`, unless another task has thrown first.
+    void spawn(lazy<> task)
+    {
+        __run(*this, std::move(task));
+    }
+
+    // starts `task` on `scheduler`.
+    template <typename Scheduler>
+    void spawn(Scheduler& scheduler, lazy<> task) requires requires(
+        Scheduler& s) { s.schedule(); }
+    {
+        __run_on(*this, scheduler, std::move(task));
+    }
+
+    // the number of spawned tasks which have not completed yet.
+    std::size_t size() const noexcept
+    {
+        return count_.load(std::memory_order_acquire) - 1;
+    }
+
+    // `co_await scope.join()` resumes when all spawned tasks have
+    // completed, and rethrows the first exception thrown by one of them. the
+    // other exceptions are dropped. the scope can be reused afterwards.
+    auto join() noexcept
+    {
+        class awaitable {
+        public:
+            explicit awaitable(async_scope& scope) noexcept
+                : scope_(scope)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return scope_.count_.load(std::memory_order_acquire) == 1;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                scope_.joiner_ = handle;
+                // drops the reference of the scope itself, the last task
+                // resumes the joiner.
+                return scope_.count_.fetch_sub(1, std::memory_order_acq_rel)
+                    != 1;
+            }
+
+            void await_resume()
+            {
+                scope_.count_.store(1, std::memory_order_relaxed);
+                if (scope_.failed_.load(std::memory_order_relaxed)) {
+                    scope_.failed_.store(false, std::memory_order_relaxed);
+                    std::rethrow_exception(std::exchange(scope_.exception_,
+                                                         nullptr));
+                }
+            }
+
+        private:
+            async_scope& scope_;
+        };
+
+        return awaitable(*this);
+    }
+
+private:
+    // gcc 12 mistakes the frames which the promise allocates with its
+    // `operator new` taking the scope, and frees with its usual `operator
+    // delete`, for mismatched allocations.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+    // `scope` is seen by the promise, which allocates from its pool.
+    static __async_scope_detail::__spawned
+    __run([[maybe_unused]] async_scope& scope, lazy<> task)
+    {
+        co_await task;
+    }
+
+    template <typename Scheduler>
+    static __async_scope_detail::__spawned
+    __run_on([[maybe_unused]] async_scope& scope,
+             Scheduler& scheduler,
+             lazy<> task)
+    {
+        co_await scheduler.schedule();
+        co_await task;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    // the exception is published to the joiner by the release of the
+    // reference of the task in `__complete()`.
+    void __fail(std::exception_ptr exception) noexcept
+    {
+        if (!failed_.exchange(true, std::memory_order_relaxed)) {
+            exception_ = std::move(exception);
+        }
+    }
+
+    void __complete() noexcept
+    {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            joiner_.resume();
+        }
+    }
+
+    // one reference for each running task, plus one for the scope itself
+    // which is dropped by `join()`.
+    std::atomic<std::size_t> count_ { 1 };
+    std::coroutine_handle<> joiner_;
+    std::atomic<bool> failed_ { false };
+    std::exception_ptr exception_;
+    __async_scope_detail::__frame_pool pool_;
+};
+
+namespace __async_scope_detail {
+    template <typename... Args>
+    void* __spawned::promise_type::operator new(std::size_t size,
+                                                async_scope& scope,
+                                                Args&...)
+    {
+        auto* block = static_cast<std::byte*>(
+            scope.pool_.allocate(size + header_size));
+        *reinterpret_cast<__frame_pool**>(block) = &scope.pool_;
+        return block + header_size;
+    }
+
+    template <typename... Args>
+    __spawned::promise_type::promise_type(async_scope& scope,
+                                          Args&...) noexcept
+        : scope_(&scope)
+    {
+        scope.count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void
+    __spawned::promise_type::__complete(async_scope* scope) noexcept
+    {
+        scope->__complete();
+    }
+
+    inline void
+    __spawned::promise_type::__fail(async_scope* scope,
+                                    std::exception_ptr exception) noexcept
+    {
+        scope->__fail(std::move(exception));
+    }
+}
+
+}
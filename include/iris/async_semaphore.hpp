@@ -0,0 +1,148 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+
+namespace iris {
+
+// a counting semaphore whose `acquire()` suspends the awaiting coroutine
+// until a unit is available. `release()` hands units directly to suspended
+// waiters in FIFO order and resumes them inline. `acquire()` takes an
+// available unit without locking, so a new acquirer may overtake waiters
+// which have not been resumed yet.
+class async_semaphore {
+public:
+    explicit async_semaphore(std::ptrdiff_t desired) noexcept
+        : count_(desired)
+    {
+        IRIS_ASSERT(desired >= 0);
+    }
+
+    async_semaphore(const async_semaphore&) = delete;
+
+    async_semaphore& operator=(const async_semaphore&) = delete;
+
+    ~async_semaphore() noexcept
+    {
+        IRIS_ASSERT(head_ == nullptr);
+    }
+
+    std::ptrdiff_t available() const noexcept
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    bool try_acquire() noexcept
+    {
+        auto count = count_.load(std::memory_order_relaxed);
+        while (count > 0) {
+            if (count_.compare_exchange_weak(count, count - 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto acquire() noexcept
+    {
+        class awaitable : public __node {
+        public:
+            explicit awaitable(async_semaphore& semaphore) noexcept
+                : semaphore_(semaphore)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return semaphore_.try_acquire();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                return semaphore_.__enqueue(*this);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            async_semaphore& semaphore_;
+        };
+
+        return awaitable(*this);
+    }
+
+    void release(std::ptrdiff_t update = 1) noexcept
+    {
+        IRIS_ASSERT(update >= 0);
+
+        __node* resumed = nullptr;
+        {
+            std::unique_lock lock(mutex_);
+            for (; update > 0 && head_ != nullptr; --update) {
+                auto* node = head_;
+                head_ = node->next_;
+                node->next_ = resumed;
+                resumed = node;
+            }
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+            if (update > 0) {
+                count_.fetch_add(update, std::memory_order_release);
+            }
+        }
+
+        // `resumed` is in reverse order, restore the FIFO order.
+        __node* fifo = nullptr;
+        while (resumed != nullptr) {
+            auto* next = resumed->next_;
+            resumed->next_ = fifo;
+            fifo = resumed;
+            resumed = next;
+        }
+
+        while (fifo != nullptr) {
+            auto* next = fifo->next_;
+            fifo->handle_.resume();
+            fifo = next;
+        }
+    }
+
+private:
+    struct __node {
+        std::coroutine_handle<> handle_;
+        __node* next_ = nullptr;
+    };
+
+    // returns false if a unit has been acquired without suspending.
+    bool __enqueue(__node& node) noexcept
+    {
+        std::unique_lock lock(mutex_);
+        if (try_acquire()) {
+            return false;
+        }
+
+        if (tail_ != nullptr) {
+            tail_->next_ = &node;
+        } else {
+            head_ = &node;
+        }
+        tail_ = &node;
+        return true;
+    }
+
+    std::atomic<std::ptrdiff_t> count_;
+    std::mutex mutex_;
+    __node* head_ = nullptr;
+    __node* tail_ = nullptr;
+};
+
+}
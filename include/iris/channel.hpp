@@ -0,0 +1,511 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/scope.hpp>
+
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace iris {
+
+// a bounded multi-producer multi-consumer channel.
+//
+// elements are stored in a lock-free ring buffer where each cell carries a
+// sequence number telling producers and consumers whether it is free or
+// full for the current lap. `try_send`/`try_receive` never block or
+// suspend. `send`/`receive` suspend the awaiting coroutine while the channel
+// is full/empty. every successful operation checks for suspended waiters
+// and, if there are any, completes their operations on their behalf and
+// resumes them inline.
+template <typename T>
+class channel {
+    static_assert(std::is_nothrow_move_constructible_v<T>);
+
+    struct __cell {
+        std::atomic<std::size_t> sequence_;
+        alignas(T) std::byte storage_[sizeof(T)];
+
+        T* get() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage_));
+        }
+    };
+
+    struct __receiver {
+        std::coroutine_handle<> handle_;
+        std::optional<T> value_;
+        __receiver* next_ = nullptr;
+    };
+
+    struct __sender {
+        std::coroutine_handle<> handle_;
+        std::optional<T> value_;
+        bool sent_ = false;
+        __sender* next_ = nullptr;
+    };
+
+    template <typename Node>
+    struct __queue {
+        Node* head_ = nullptr;
+        Node* tail_ = nullptr;
+
+        void push(Node& node) noexcept
+        {
+            node.next_ = nullptr;
+            if (tail_ != nullptr) {
+                tail_->next_ = &node;
+            } else {
+                head_ = &node;
+            }
+            tail_ = &node;
+        }
+
+        Node* pop() noexcept
+        {
+            auto* node = head_;
+            if (node != nullptr) {
+                head_ = node->next_;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+            }
+            return node;
+        }
+    };
+
+public:
+    using value_type = T;
+
+    // `capacity` is rounded up to a power of two.
+    explicit channel(std::size_t capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity) - 1)
+        , cells_(std::make_unique<__cell[]>(mask_ + 1))
+    {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    channel(const channel&) = delete;
+
+    channel& operator=(const channel&) = delete;
+
+    ~channel() noexcept
+    {
+        IRIS_ASSERT(waiters_.load(std::memory_order_relaxed) == 0);
+        while (__try_receive_one()) {
+        }
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    bool closed() const noexcept
+    {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    // after closing, sending fails and receiving fails once the channel has
+    // been drained. suspended senders and receivers are resumed.
+    void close() noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            closed_.store(true, std::memory_order_release);
+        }
+        __wake();
+    }
+
+    // returns false if the channel is full or closed.
+    template <typename U>
+    bool try_send(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>)
+    {
+        if (closed()) {
+            return false;
+        }
+
+        if (__try_send(std::forward<U>(value))) {
+            __wake();
+            return true;
+        }
+
+        return false;
+    }
+
+    // moves up to `count` elements from `first` into the channel with a
+    // single claim of the ring buffer, returns the number of elements sent.
+    template <std::input_iterator I>
+    std::size_t try_send_n(I first, std::size_t count)
+    {
+        if (closed() || count == 0) {
+            return 0;
+        }
+
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        std::size_t claimed = 0;
+        while (true) {
+            // the cells of a lap are freed out of order, claim the run of
+            // free cells at the head.
+            claimed = 0;
+            while (claimed < count && claimed <= mask_) {
+                auto& cell = cells_[(pos + claimed) & mask_];
+                if (cell.sequence_.load(std::memory_order_acquire)
+                    != pos + claimed) {
+                    break;
+                }
+                ++claimed;
+            }
+
+            if (claimed == 0) {
+                auto current = enqueue_pos_.load(std::memory_order_relaxed);
+                if (current == pos) {
+                    return 0;
+                }
+                pos = current;
+                continue;
+            }
+
+            if (enqueue_pos_.compare_exchange_weak(
+                    pos, pos + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < claimed; ++i, ++first) {
+            auto& cell = cells_[(pos + i) & mask_];
+            std::construct_at(cell.get(), std::move(*first));
+            cell.sequence_.store(pos + i + 1, std::memory_order_release);
+        }
+
+        __wake();
+        return claimed;
+    }
+
+    // returns `nullopt` if the channel is empty.
+    std::optional<T> try_receive() noexcept
+    {
+        auto result = __try_receive_one();
+        if (result) {
+            __wake();
+        }
+        return result;
+    }
+
+    // moves up to `count` elements to `out` with a single claim of the ring
+    // buffer, returns the number of elements received. if writing to `out`
+    // throws, the claimed elements which have not been written are
+    // destroyed.
+    template <std::output_iterator<T&&> O>
+    std::size_t try_receive_n(O out, std::size_t count)
+    {
+        // the cells released on unwind may let suspended senders proceed.
+        scope_failure wake([this]() noexcept { __wake(); });
+        auto received = __try_receive_n(
+            [&](T&& value) { *out++ = std::move(value); }, count);
+        if (received > 0) {
+            __wake();
+        }
+        return received;
+    }
+
+    // `co_await channel.send(value)` suspends while the channel is full,
+    // returns false if the channel is closed.
+    auto send(T value) noexcept
+    {
+        class awaitable : private __sender {
+        public:
+            awaitable(channel& owner, T&& value) noexcept
+                : channel_(owner)
+            {
+                this->value_.emplace(std::move(value));
+            }
+
+            bool await_ready() noexcept
+            {
+                this->sent_ = channel_.try_send(std::move(*this->value_));
+                return this->sent_ || channel_.closed();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                this->handle_ = handle;
+                return channel_.__suspend(*this);
+            }
+
+            bool await_resume() noexcept
+            {
+                return this->sent_;
+            }
+
+        private:
+            channel& channel_;
+        };
+
+        return awaitable(*this, std::move(value));
+    }
+
+    // `co_await channel.receive()` suspends while the channel is empty,
+    // returns `nullopt` if the channel is closed and drained.
+    auto receive() noexcept
+    {
+        class awaitable : private __receiver {
+        public:
+            explicit awaitable(channel& owner) noexcept
+                : channel_(owner)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                this->value_ = channel_.try_receive();
+                return this->value_.has_value() || channel_.closed();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                this->handle_ = handle;
+                return channel_.__suspend(*this);
+            }
+
+            std::optional<T> await_resume() noexcept
+            {
+                return std::move(this->value_);
+            }
+
+        private:
+            channel& channel_;
+        };
+
+        return awaitable(*this);
+    }
+
+private:
+    template <typename U>
+    bool __try_send(U&& value)
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos & mask_];
+            auto sequence = cell.sequence_.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    std::construct_at(cell.get(), std::forward<U>(value));
+                    cell.sequence_.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename F>
+    std::size_t __try_receive_n(F&& f, std::size_t count)
+    {
+        if (count == 0) {
+            return 0;
+        }
+
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+        std::size_t claimed = 0;
+        while (true) {
+            claimed = 0;
+            while (claimed < count && claimed <= mask_) {
+                auto& cell = cells_[(pos + claimed) & mask_];
+                if (cell.sequence_.load(std::memory_order_acquire)
+                    != pos + claimed + 1) {
+                    break;
+                }
+                ++claimed;
+            }
+
+            if (claimed == 0) {
+                auto current = dequeue_pos_.load(std::memory_order_relaxed);
+                if (current == pos) {
+                    return 0;
+                }
+                pos = current;
+                continue;
+            }
+
+            if (dequeue_pos_.compare_exchange_weak(
+                    pos, pos + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        std::size_t i = 0;
+        auto release = [&]() noexcept {
+            auto& cell = cells_[(pos + i) & mask_];
+            std::destroy_at(cell.get());
+            cell.sequence_.store(pos + i + mask_ + 1,
+                                 std::memory_order_release);
+        };
+
+        // the claim cannot be undone, if `f` throws the remaining claimed
+        // cells are released with their elements destroyed.
+        scope_exit guard([&]() noexcept {
+            for (; i < claimed; ++i) {
+                release();
+            }
+        });
+
+        for (; i < claimed; ++i) {
+            f(std::move(*cells_[(pos + i) & mask_].get()));
+            release();
+        }
+
+        return claimed;
+    }
+
+    std::optional<T> __try_receive_one() noexcept
+    {
+        std::optional<T> result;
+        __try_receive_n(
+            [&](T&& value) noexcept { result.emplace(std::move(value)); }, 1);
+        return result;
+    }
+
+    // returns false if the operation completed without suspending.
+    bool __suspend(__sender& sender) noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // retry now that concurrent operations are guaranteed to see
+            // the waiter.
+            if (closed_.load(std::memory_order_relaxed)) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (!__try_send(std::move(*sender.value_))) {
+                senders_.push(sender);
+                return true;
+            }
+
+            sender.sent_ = true;
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        __wake();
+        return false;
+    }
+
+    bool __suspend(__receiver& receiver) noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            receiver.value_ = __try_receive_one();
+            if (!receiver.value_.has_value()) {
+                if (closed_.load(std::memory_order_relaxed)) {
+                    waiters_.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                receivers_.push(receiver);
+                return true;
+            }
+
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        __wake();
+        return false;
+    }
+
+    // completes the operations of suspended waiters as far as the state of
+    // the ring buffer allows, and resumes them.
+    void __wake() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        __queue<__receiver> receivers;
+        __queue<__sender> senders;
+        {
+            std::unique_lock lock(mutex_);
+            std::size_t completed = 0;
+            bool progress = true;
+            while (progress) {
+                progress = false;
+                while (receivers_.head_ != nullptr) {
+                    auto value = __try_receive_one();
+                    if (!value) {
+                        break;
+                    }
+                    auto* receiver = receivers_.pop();
+                    receiver->value_ = std::move(value);
+                    receivers.push(*receiver);
+                    progress = true;
+                    ++completed;
+                }
+                while (senders_.head_ != nullptr
+                       && !closed_.load(std::memory_order_relaxed)) {
+                    if (!__try_send(std::move(*senders_.head_->value_))) {
+                        break;
+                    }
+                    auto* sender = senders_.pop();
+                    sender->sent_ = true;
+                    senders.push(*sender);
+                    progress = true;
+                    ++completed;
+                }
+            }
+
+            if (closed_.load(std::memory_order_relaxed)) {
+                // the channel has been drained, pending receivers fail.
+                while (auto* receiver = receivers_.pop()) {
+                    receivers.push(*receiver);
+                    ++completed;
+                }
+                while (auto* sender = senders_.pop()) {
+                    senders.push(*sender);
+                    ++completed;
+                }
+            }
+
+            waiters_.fetch_sub(completed, std::memory_order_relaxed);
+        }
+
+        while (auto* receiver = receivers.pop()) {
+            receiver->handle_.resume();
+        }
+        while (auto* sender = senders.pop()) {
+            sender->handle_.resume();
+        }
+    }
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos_ { 0 };
+    alignas(64) std::atomic<std::size_t> dequeue_pos_ { 0 };
+    alignas(64) std::atomic<std::size_t> waiters_ { 0 };
+    std::atomic<bool> closed_ { false };
+    const std::size_t mask_;
+    std::unique_ptr<__cell[]> cells_;
+    std::mutex mutex_;
+    __queue<__receiver> receivers_;
+    __queue<__sender> senders_;
+};
+
+}
@@ -7,3 +7,12 @@
 #define IRIS_ASSERT(x) assert(x)
 #define IRIS_UNUSED(x) (void)x
 #define IRIS_FIX_CLANG_FORMAT_PLACEHOLDER 0
+
+// coroutine tracing hooks, see <iris/trace.hpp>. compiled out unless
+// `IRIS_ENABLE_TRACING` is defined.
+#if defined(IRIS_ENABLE_TRACING)
+#define IRIS_TRACE(kind, frame, name)                                          \
+    ::iris::__detail::__trace_emit(::iris::trace_event_kind::kind, frame, name)
+#else
+#define IRIS_TRACE(kind, frame, name) IRIS_UNUSED(0)
+#endif
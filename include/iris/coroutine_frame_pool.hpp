@@ -0,0 +1,242 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace iris {
+namespace __coroutine_frame_pool_detail {
+    class __thread_cache;
+
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) __block {
+        union {
+            // the cache the block is allocated from, or nullptr if it is
+            // not cached.
+            __thread_cache* owner_;
+            // the next block in a free list.
+            __block* next_;
+        };
+        std::uint32_t size_class_;
+    };
+
+    // a per-thread set of size class free lists. blocks released by other
+    // threads are pushed onto a lock-free stack which the owner drains once
+    // its free list runs out. the cache outlives its thread until all of the
+    // blocks allocated from it are released.
+    class __thread_cache {
+    public:
+        static constexpr std::size_t granularity = 64;
+        static constexpr std::size_t size_classes = 32;
+        static constexpr std::size_t max_cached = 64;
+
+        static void* allocate(std::size_t size)
+        {
+            auto n = (size + sizeof(__block) + granularity - 1) / granularity;
+            auto cache = __local();
+            if (n > size_classes || cache == nullptr) {
+                auto block = ::new (::operator new(size + sizeof(__block)))
+                    __block { { nullptr }, 0 };
+                return block + 1;
+            }
+
+            return cache->__allocate(static_cast<std::uint32_t>(n - 1));
+        }
+
+        static void deallocate(void* p) noexcept
+        {
+            auto block = static_cast<__block*>(p) - 1;
+            auto owner = block->owner_;
+            if (owner == nullptr) {
+                ::operator delete(block);
+            } else if (owner == __current()) {
+                owner->__deallocate(block);
+            } else {
+                owner->__return(block);
+            }
+        }
+
+    private:
+        struct __holder {
+            __holder()
+                : cache_(new __thread_cache())
+            {
+            }
+
+            ~__holder()
+            {
+                __current() = nullptr;
+                __exited() = true;
+                cache_->__close();
+            }
+
+            __thread_cache* cache_;
+        };
+
+        static __thread_cache*& __current() noexcept
+        {
+            thread_local __thread_cache* current = nullptr;
+            return current;
+        }
+
+        static bool& __exited() noexcept
+        {
+            thread_local bool exited = false;
+            return exited;
+        }
+
+        static __thread_cache* __local()
+        {
+            auto& current = __current();
+            if (current == nullptr && !__exited()) {
+                thread_local __holder holder;
+                current = holder.cache_;
+            }
+            return current;
+        }
+
+        static __block* __closed() noexcept
+        {
+            static __block closed {};
+            return &closed;
+        }
+
+        void* __allocate(std::uint32_t size_class)
+        {
+            if (free_[size_class] == nullptr) {
+                __drain();
+            }
+
+            auto block = free_[size_class];
+            if (block != nullptr) {
+                free_[size_class] = block->next_;
+                --cached_[size_class];
+            } else {
+                block = static_cast<__block*>(
+                    ::operator new((size_class + 1) * granularity));
+            }
+
+            block->owner_ = this;
+            block->size_class_ = size_class;
+            ++owned_;
+            return block + 1;
+        }
+
+        void __deallocate(__block* block) noexcept
+        {
+            --owned_;
+            auto size_class = block->size_class_;
+            if (cached_[size_class] == max_cached) {
+                ::operator delete(block);
+                return;
+            }
+
+            block->next_ = free_[size_class];
+            free_[size_class] = block;
+            ++cached_[size_class];
+        }
+
+        void __return(__block* block) noexcept
+        {
+            auto head = returned_.load(std::memory_order_relaxed);
+            do {
+                if (head == __closed()) {
+                    // the owner has exited, the last block returned
+                    // releases the cache.
+                    ::operator delete(block);
+                    if (orphans_.fetch_sub(1, std::memory_order_acq_rel)
+                        == 1) {
+                        delete this;
+                    }
+                    return;
+                }
+                block->next_ = head;
+            } while (!returned_.compare_exchange_weak(
+                head, block, std::memory_order_release,
+                std::memory_order_relaxed));
+        }
+
+        void __drain() noexcept
+        {
+            auto block = returned_.exchange(nullptr, std::memory_order_acquire);
+            while (block != nullptr) {
+                __deallocate(std::exchange(block, block->next_));
+            }
+        }
+
+        void __close() noexcept
+        {
+            auto block
+                = returned_.exchange(__closed(), std::memory_order_acq_rel);
+            while (block != nullptr) {
+                --owned_;
+                ::operator delete(std::exchange(block, block->next_));
+            }
+
+            for (auto& head : free_) {
+                while (head != nullptr) {
+                    ::operator delete(std::exchange(head, head->next_));
+                }
+            }
+
+            // `orphans_` may have wrapped around below zero if blocks were
+            // returned in the meantime.
+            if (orphans_.fetch_add(owned_, std::memory_order_acq_rel) + owned_
+                == 0) {
+                delete this;
+            }
+        }
+
+        __block* free_[size_classes] {};
+        std::uint32_t cached_[size_classes] {};
+        std::size_t owned_ = 0;
+        alignas(64) std::atomic<__block*> returned_ { nullptr };
+        std::atomic<std::size_t> orphans_ { 0 };
+    };
+}
+
+// an allocator for coroutine frames, which keeps released frames in
+// thread-local size class free lists for reuse. it can be passed to
+// coroutines via `std::allocator_arg`, or used as the `Allocator` of
+// `generator`. frames may be released on any thread.
+template <typename T = std::byte>
+class coroutine_frame_pool {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    coroutine_frame_pool() = default;
+
+    template <typename U>
+    coroutine_frame_pool(const coroutine_frame_pool<U>&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(
+            __coroutine_frame_pool_detail::__thread_cache::allocate(
+                n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        IRIS_UNUSED(n);
+        __coroutine_frame_pool_detail::__thread_cache::deallocate(p);
+    }
+
+    template <typename U>
+    friend bool operator==(const coroutine_frame_pool&,
+                           const coroutine_frame_pool<U>&) noexcept
+    {
+        return true;
+    }
+};
+
+}
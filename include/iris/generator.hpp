@@ -2,69 +2,21 @@
 
 #include <iris/config.hpp>
 
+#include <iris/__detail/frame_allocator.hpp>
 #include <iris/ranges/elements_of.hpp>
+#if defined(IRIS_ENABLE_TRACING)
+#include <iris/trace.hpp>
+#endif
 
 #include <coroutine>
+#include <memory>
+#include <optional>
 #include <ranges>
 #include <type_traits>
 
 namespace iris {
 namespace __generator_detail {
-    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) __default_new_alignment {
-        std::byte d[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
-    };
-
-    constexpr std::size_t __aligned_allocated_count(std::size_t size)
-    {
-        return (size + __STDCPP_DEFAULT_NEW_ALIGNMENT__ - 1)
-            / __STDCPP_DEFAULT_NEW_ALIGNMENT__;
-    }
-
-    template <typename Allocator>
-    class __frame_allocator {
-    public:
-        using pointer = typename std::allocator_traits<Allocator>::pointer;
-
-        static constexpr void* allocate(Allocator allocator, std::size_t size)
-        {
-            auto n = __aligned_allocated_count(size);
-            auto a = std::size_t(0);
-            if constexpr (!std::allocator_traits<
-                              Allocator>::is_always_equal::value) {
-                a = __aligned_allocated_count(sizeof(Allocator));
-            }
-
-            auto p = allocator.allocate(n + a);
-
-            if constexpr (!std::allocator_traits<
-                              Allocator>::is_always_equal::value) {
-                std::construct_at(get_allocator(p, n), std::move(allocator));
-            }
-
-            return p;
-        }
-
-        static constexpr void deallocate(void* p, std::size_t size)
-        {
-            auto n = __aligned_allocated_count(size);
-            if constexpr (!std::allocator_traits<
-                              Allocator>::is_always_equal::value) {
-                Allocator allocator = std::move(*get_allocator(p, n));
-                std::destroy_at(get_allocator(p, n));
-                auto a = __aligned_allocated_count(sizeof(Allocator));
-                allocator.deallocate(static_cast<pointer>(p), n + a);
-            } else {
-                Allocator allocator;
-                allocator.deallocate(static_cast<pointer>(p), n);
-            }
-        }
-
-    private:
-        static constexpr Allocator* get_allocator(void* p, std::size_t n)
-        {
-            return reinterpret_cast<Allocator*>(static_cast<pointer>(p) + n);
-        }
-    };
+    struct __empty { };
 }
 
 template <typename R, typename V = void, typename Allocator = void>
@@ -95,17 +47,24 @@ public:
         promise_type()
             : root_(std::coroutine_handle<promise_type>::from_promise(*this))
         {
+            IRIS_TRACE(create, root_.address(), "generator");
         }
 
         generator get_return_object() noexcept;
 
         auto initial_suspend() noexcept
         {
+#if defined(IRIS_ENABLE_TRACING)
+            return __detail::__traced_initial_suspend("generator");
+#else
             return std::suspend_always();
+#endif
         }
 
         auto final_suspend() noexcept
         {
+            IRIS_TRACE(complete, __frame(), "generator");
+
             class awaitable {
             public:
                 bool await_ready() noexcept
@@ -149,6 +108,7 @@ public:
 
         auto yield_value(yielded value) noexcept
         {
+            IRIS_TRACE(suspend, __frame(), "generator");
             root_.promise().set_value(&value);
             return std::suspend_always();
         }
@@ -188,6 +148,7 @@ public:
                 && std::constructible_from<std::remove_cvref_t<yielded>, const Yielded&>
         // clang-format on
         {
+            IRIS_TRACE(suspend, __frame(), "generator");
             return yield_lvalue_awaitable { lvalue };
         }
 
@@ -203,6 +164,8 @@ public:
             auto
             await_suspend(std::coroutine_handle<promise_type> handle) noexcept
             {
+                IRIS_TRACE(suspend, handle.address(), "generator");
+
                 // child coroutine should yield value to root coroutine.
                 child_.handle().promise().root_ = handle.promise().root_;
 
@@ -218,6 +181,12 @@ public:
 
             void await_resume()
             {
+                if (child_.handle()) {
+                    IRIS_TRACE(resume,
+                               child_.handle().promise().parent_.address(),
+                               "generator");
+                }
+
                 auto& root_promise = child_.handle().promise().root_.promise();
                 if (root_promise.exception_) {
                     std::rethrow_exception(root_promise.exception_);
@@ -265,6 +234,95 @@ public:
                 nested(std::allocator_arg, range.allocator, &range.range)));
         }
 
+        // hands out the elements of a contiguous range one after another
+        // without resuming the coroutine in between.
+        template <typename Element>
+        class yield_batch_awaitable {
+            friend class promise_type;
+
+            // elements are copied if they can not be referred to as
+            // `yielded`, e.g. `const T` for `generator<T>`.
+            static constexpr bool copies = !std::is_convertible_v<
+                Element*, std::add_pointer_t<yielded>>;
+
+            using slot_type = std::conditional_t<
+                copies,
+                std::optional<std::remove_cvref_t<yielded>>,
+                __generator_detail::__empty>;
+
+        public:
+            bool await_ready() noexcept
+            {
+                return first_ == last_;
+            }
+
+            void await_suspend(std::coroutine_handle<promise_type> handle)
+            {
+                IRIS_TRACE(suspend, handle.address(), "generator");
+                root_ = &handle.promise().root_.promise();
+                set_value();
+                root_->batch_ = this;
+                root_->batch_next_ = &next;
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            yield_batch_awaitable(Element* first, Element* last) noexcept
+                : first_(first)
+                , last_(last)
+            {
+            }
+
+            static bool next(void* self)
+            {
+                auto& awaitable = *static_cast<yield_batch_awaitable*>(self);
+                if (++awaitable.first_ == awaitable.last_) {
+                    return false;
+                }
+
+                awaitable.set_value();
+                return true;
+            }
+
+            void set_value()
+            {
+                if constexpr (copies) {
+                    slot_.emplace(*first_);
+                    root_->set_value(std::addressof(*slot_));
+                } else {
+                    root_->set_value(first_);
+                }
+            }
+
+            Element* first_;
+            Element* last_;
+            promise_type* root_ = nullptr;
+            [[no_unique_address]] slot_type slot_;
+        };
+
+        template <std::ranges::contiguous_range Range, typename Allocator2>
+        auto yield_value(ranges::elements_of<Range, Allocator2> range) noexcept
+            requires std::ranges::sized_range<Range> && std::convertible_to<
+                std::ranges::range_reference_t<Range>,
+                yielded>
+        {
+            return yield_batch(range.range);
+        }
+
+        // clang-format off
+        template <std::ranges::contiguous_range Range, typename Allocator2>
+        auto yield_value(ranges::elements_of<Range, Allocator2> range) noexcept
+            requires std::ranges::sized_range<Range>
+                && std::is_rvalue_reference_v<yielded>
+                && (!std::convertible_to<std::ranges::range_reference_t<Range>, yielded>)
+                && std::constructible_from<std::remove_cvref_t<yielded>,
+                                           std::ranges::range_reference_t<Range>>
+        // clang-format on
+        {
+            return yield_batch(range.range);
+        }
+
         void await_transform() = delete;
 
         void return_void() noexcept { }
@@ -276,6 +334,7 @@ public:
 
         void resume()
         {
+            IRIS_TRACE(resume, root_.address(), "generator");
             root_.resume();
         }
 
@@ -283,12 +342,12 @@ public:
             std::same_as<Allocator,
                          void> || std::default_initializable<Allocator>
         {
-            using U = __generator_detail::__default_new_alignment;
+            using U = __detail::__default_new_alignment;
             using BAlloc = std::allocator_traits<std::conditional_t<
                 std::same_as<Allocator, void>, std::allocator<void>,
                 Allocator>>::template rebind_alloc<U>;
 
-            return __generator_detail::__frame_allocator<BAlloc>::allocate(
+            return __detail::__frame_allocator<BAlloc>::allocate(
                 BAlloc(), size);
         }
 
@@ -300,12 +359,12 @@ public:
                                   Alloc&& alloc,
                                   Args&...)
         {
-            using U = __generator_detail::__default_new_alignment;
+            using U = __detail::__default_new_alignment;
             using BAlloc = std::allocator_traits<std::conditional_t<
                 std::same_as<Allocator, void>, std::allocator<void>,
                 Allocator>>::template rebind_alloc<U>;
 
-            return __generator_detail::__frame_allocator<BAlloc>::allocate(
+            return __detail::__frame_allocator<BAlloc>::allocate(
                 std::forward<Alloc>(alloc), size);
         }
 
@@ -318,28 +377,48 @@ public:
                                   Alloc&& alloc,
                                   Args&...)
         {
-            using U = __generator_detail::__default_new_alignment;
+            using U = __detail::__default_new_alignment;
             using BAlloc = std::allocator_traits<std::conditional_t<
                 std::same_as<Allocator, void>, std::allocator<void>,
                 Allocator>>::template rebind_alloc<U>;
 
-            return __generator_detail::__frame_allocator<BAlloc>::allocate(
+            return __detail::__frame_allocator<BAlloc>::allocate(
                 std::forward<Alloc>(alloc), size);
         }
 
         static void operator delete(void* pointer, std::size_t size)
         {
-            using U = __generator_detail::__default_new_alignment;
+            using U = __detail::__default_new_alignment;
             using BAlloc = std::allocator_traits<std::conditional_t<
                 std::same_as<Allocator, void>, std::allocator<void>,
                 Allocator>>::template rebind_alloc<U>;
 
-            return __generator_detail::__frame_allocator<BAlloc>::deallocate(
+            return __detail::__frame_allocator<BAlloc>::deallocate(
                 pointer, size);
         }
 
     private:
+        template <typename Range>
+        auto yield_batch(Range& range) noexcept
+        {
+            using element_type = std::remove_reference_t<
+                std::ranges::range_reference_t<Range>>;
+            auto first = std::ranges::data(range);
+            return yield_batch_awaitable<element_type>(
+                first, first + std::ranges::size(range));
+        }
+
+        void* __frame() noexcept
+        {
+            return std::coroutine_handle<promise_type>::from_promise(*this)
+                .address();
+        }
+
         std::add_pointer_t<yielded> value_ = nullptr;
+        // the batch of elements the consumer is walking through, see
+        // `yield_batch_awaitable`.
+        void* batch_ = nullptr;
+        bool (*batch_next_)(void*) = nullptr;
         std::exception_ptr exception_;
         std::coroutine_handle<promise_type> root_;
         std::coroutine_handle<promise_type> parent_;
@@ -374,7 +453,14 @@ public:
         iterator& operator++()
         {
             IRIS_ASSERT(handle_ && !handle_.done());
-            handle_.promise().resume();
+            auto& promise = handle_.promise();
+            if (promise.batch_next_) {
+                if (promise.batch_next_(promise.batch_)) {
+                    return *this;
+                }
+                promise.batch_next_ = nullptr;
+            }
+            promise.resume();
             return *this;
         }
 
@@ -0,0 +1,584 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#if defined(__linux__)
+
+#include <iris/__detail/timer_wheel.hpp>
+#include <iris/expected.hpp>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace iris {
+
+class io_context;
+class socket;
+
+namespace __io_detail {
+    struct __uring;
+
+    // intrusive node for an operation waiting in the io_context. it lives in
+    // the awaitable, so queuing and completing operations never allocates.
+    struct __operation {
+        // attempts the operation, returns false if it would block. a posted
+        // operation runs `perform_` instead of resuming `handle_` if set.
+        bool (*perform_)(__operation*) noexcept = nullptr;
+        std::coroutine_handle<> handle_;
+        __operation* next_ = nullptr;
+    };
+
+    // per-descriptor state registered with epoll. each direction holds
+    // `nullptr` (idle), `__ready()` (an edge arrived while nobody was
+    // waiting) or the parked `__operation`.
+    struct __descriptor {
+        int fd_ = -1;
+        std::atomic<void*> read_ { nullptr };
+        std::atomic<void*> write_ { nullptr };
+        __descriptor* next_ = nullptr;
+
+        static void* __ready() noexcept
+        {
+            static char ready;
+            return &ready;
+        }
+    };
+
+    // a timer which can be armed from any thread. if armed from outside
+    // the event loop, it is posted to the event loop as an operation first.
+    // a timer cancelled before that insertion runs is fired right away
+    // instead, so that its owner still learns when it is released.
+    struct __timer : __operation, __detail::__timer_node {
+        io_context* context_ = nullptr;
+        bool cancelled_ = false;
+    };
+
+    // returns true if `op` is parked on `slot`, false if it has completed.
+    bool __park(std::atomic<void*>& slot, __operation& op) noexcept;
+
+    void __signal(std::atomic<void*>& slot) noexcept;
+
+    // an operation waiting for readiness of a descriptor, it is completed
+    // by `perform_` or cancelled when the descriptor is closed.
+    class __reactor_operation : public __operation {
+    public:
+        // completes the operation with `operation_canceled` once posted.
+        void cancel() noexcept
+        {
+            perform_ = nullptr;
+            error_ = static_cast<int>(std::errc::operation_canceled);
+        }
+
+    protected:
+        // returns false if the operation would block.
+        bool complete(long result) noexcept
+        {
+            if (result >= 0) {
+                result_ = static_cast<std::size_t>(result);
+                return true;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return false;
+            }
+
+            error_ = errno;
+            return true;
+        }
+
+        expected<std::size_t, std::error_code> result() const noexcept
+        {
+            if (error_ != 0) {
+                return unexpected(
+                    std::error_code(error_, std::generic_category()));
+            }
+
+            return result_;
+        }
+
+    private:
+        std::size_t result_ = 0;
+        int error_ = 0;
+    };
+
+    template <typename Derived>
+    class __reactor_awaitable : public __reactor_operation {
+    public:
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            handle_ = handle;
+            return __park(static_cast<Derived*>(this)->slot(), *this);
+        }
+
+    protected:
+        __reactor_awaitable() noexcept
+        {
+            perform_ = [](__operation* op) noexcept {
+                return static_cast<Derived*>(op)->perform();
+            };
+        }
+    };
+}
+
+class ipv4_endpoint {
+public:
+    constexpr ipv4_endpoint() noexcept = default;
+
+    constexpr ipv4_endpoint(std::array<std::uint8_t, 4> address,
+                            std::uint16_t port) noexcept
+        : address_(address)
+        , port_(port)
+    {
+    }
+
+    static constexpr ipv4_endpoint loopback(std::uint16_t port = 0) noexcept
+    {
+        return ipv4_endpoint({ 127, 0, 0, 1 }, port);
+    }
+
+    constexpr std::array<std::uint8_t, 4> address() const noexcept
+    {
+        return address_;
+    }
+
+    constexpr std::uint16_t port() const noexcept
+    {
+        return port_;
+    }
+
+    friend constexpr bool operator==(const ipv4_endpoint&,
+                                     const ipv4_endpoint&)
+        = default;
+
+private:
+    std::array<std::uint8_t, 4> address_ {};
+    std::uint16_t port_ = 0;
+};
+
+class io_context {
+    friend class socket;
+    friend class acceptor;
+    friend struct __io_detail::__uring;
+
+public:
+    io_context();
+
+    io_context(const io_context&) = delete;
+
+    io_context& operator=(const io_context&) = delete;
+
+    ~io_context() noexcept;
+
+    // runs the event loop on the calling thread until `stop()` is called.
+    void run();
+
+    // runs the event loop on the calling thread until `stop()` is called or
+    // `duration` has elapsed.
+    void run_for(std::chrono::nanoseconds duration);
+
+    // runs all handlers that are ready without blocking, returns the number
+    // of handlers run.
+    std::size_t poll();
+
+    void stop() noexcept;
+
+    bool stopped() const noexcept
+    {
+        return stopped_.load(std::memory_order_acquire);
+    }
+
+    void restart() noexcept
+    {
+        stopped_.store(false, std::memory_order_release);
+    }
+
+    // thread-safe, `handle` is resumed on the thread running the event loop.
+    void post(__io_detail::__operation& op) noexcept;
+
+    // true if the calling thread is running the event loop of `*this`.
+    bool running_in_this_thread() const noexcept;
+
+    auto schedule() noexcept
+    {
+        class awaitable : private __io_detail::__operation {
+        public:
+            explicit awaitable(io_context& context) noexcept
+                : context_(context)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                context_.post(*this);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            io_context& context_;
+        };
+
+        return awaitable(*this);
+    }
+
+    // suspends the awaiting coroutine until `deadline` and resumes it on the
+    // event loop, with a resolution of one millisecond.
+    auto sleep_until(std::chrono::steady_clock::time_point deadline) noexcept
+    {
+        class awaitable : private __io_detail::__timer {
+        public:
+            awaitable(io_context& context,
+                      std::chrono::steady_clock::time_point deadline) noexcept
+                : deadline_(deadline)
+            {
+                context_ = &context;
+                fire_ = [](__detail::__timer_node* node) noexcept {
+                    static_cast<awaitable*>(node)->handle_.resume();
+                };
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                context_->__add_timer(*this, deadline_);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            std::chrono::steady_clock::time_point deadline_;
+        };
+
+        return awaitable(*this, deadline);
+    }
+
+    auto sleep_for(std::chrono::nanoseconds duration) noexcept
+    {
+        return sleep_until(std::chrono::steady_clock::now() + duration);
+    }
+
+    // arms `timer` to fire at `deadline` on the event loop. thread-safe.
+    void __add_timer(__io_detail::__timer& timer,
+                     std::chrono::steady_clock::time_point deadline) noexcept;
+
+    // disarms `timer`, returns false if it has already fired, or if its
+    // insertion is still posted, in which case it fires once that runs. must
+    // be called on the event loop.
+    bool __cancel_timer(__io_detail::__timer& timer) noexcept;
+
+private:
+    using __timer_resolution = std::chrono::milliseconds;
+
+    std::uint64_t
+    __to_tick(std::chrono::steady_clock::time_point time) const noexcept;
+
+    std::size_t __run_once(int timeout);
+
+    std::size_t __run_posted() noexcept;
+
+    __io_detail::__descriptor* __register(int fd);
+
+    void __deregister(__io_detail::__descriptor* descriptor) noexcept;
+
+    int epoll_fd_ = -1;
+    int event_fd_ = -1;
+    int timer_fd_ = -1;
+    std::atomic<bool> stopped_ { false };
+    bool timer_expired_ = false;
+    std::atomic<__io_detail::__operation*> posted_ { nullptr };
+    std::mutex retired_mutex_;
+    __io_detail::__descriptor* retired_ = nullptr;
+    std::chrono::steady_clock::time_point epoch_
+        = std::chrono::steady_clock::now();
+    __detail::__timer_wheel timers_;
+};
+
+class socket {
+    friend class acceptor;
+
+public:
+    // adopts `fd` and switches it to non-blocking mode.
+    socket(io_context& context, int fd);
+
+    socket(const socket&) = delete;
+
+    socket(socket&& other) noexcept
+        : context_(other.context_)
+        , descriptor_(std::exchange(other.descriptor_, nullptr))
+    {
+    }
+
+    socket& operator=(const socket&) = delete;
+
+    socket& operator=(socket&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            context_ = other.context_;
+            descriptor_ = std::exchange(other.descriptor_, nullptr);
+        }
+        return *this;
+    }
+
+    ~socket() noexcept
+    {
+        close();
+    }
+
+    static expected<std::pair<socket, socket>, std::error_code>
+    open_pair(io_context& context);
+
+    static expected<socket, std::error_code> open(io_context& context);
+
+    void close() noexcept;
+
+    bool is_open() const noexcept
+    {
+        return descriptor_ != nullptr;
+    }
+
+    int native_handle() const noexcept
+    {
+        return descriptor_ ? descriptor_->fd_ : -1;
+    }
+
+    expected<ipv4_endpoint, std::error_code> local_endpoint() const noexcept;
+
+    auto async_read(std::span<std::byte> buffer) noexcept
+    {
+        class awaitable : public __io_detail::__reactor_awaitable<awaitable> {
+            friend class __io_detail::__reactor_awaitable<awaitable>;
+
+        public:
+            awaitable(__io_detail::__descriptor& descriptor,
+                      std::span<std::byte> buffer) noexcept
+                : descriptor_(descriptor)
+                , buffer_(buffer)
+            {
+            }
+
+            expected<std::size_t, std::error_code> await_resume() noexcept
+            {
+                return this->result();
+            }
+
+        private:
+            std::atomic<void*>& slot() noexcept
+            {
+                return descriptor_.read_;
+            }
+
+            bool perform() noexcept
+            {
+                return this->complete(
+                    __read(descriptor_.fd_, buffer_.data(), buffer_.size()));
+            }
+
+            __io_detail::__descriptor& descriptor_;
+            std::span<std::byte> buffer_;
+        };
+
+        IRIS_ASSERT(is_open());
+        return awaitable(*descriptor_, buffer);
+    }
+
+    auto async_write(std::span<const std::byte> buffer) noexcept
+    {
+        class awaitable : public __io_detail::__reactor_awaitable<awaitable> {
+            friend class __io_detail::__reactor_awaitable<awaitable>;
+
+        public:
+            awaitable(__io_detail::__descriptor& descriptor,
+                      std::span<const std::byte> buffer) noexcept
+                : descriptor_(descriptor)
+                , buffer_(buffer)
+            {
+            }
+
+            expected<std::size_t, std::error_code> await_resume() noexcept
+            {
+                return this->result();
+            }
+
+        private:
+            std::atomic<void*>& slot() noexcept
+            {
+                return descriptor_.write_;
+            }
+
+            bool perform() noexcept
+            {
+                return this->complete(
+                    __write(descriptor_.fd_, buffer_.data(), buffer_.size()));
+            }
+
+            __io_detail::__descriptor& descriptor_;
+            std::span<const std::byte> buffer_;
+        };
+
+        IRIS_ASSERT(is_open());
+        return awaitable(*descriptor_, buffer);
+    }
+
+    auto async_connect(const ipv4_endpoint& endpoint) noexcept
+    {
+        class awaitable : public __io_detail::__reactor_awaitable<awaitable> {
+            friend class __io_detail::__reactor_awaitable<awaitable>;
+
+        public:
+            awaitable(__io_detail::__descriptor& descriptor,
+                      const ipv4_endpoint& endpoint) noexcept
+                : descriptor_(descriptor)
+                , endpoint_(endpoint)
+            {
+            }
+
+            expected<void, std::error_code> await_resume() noexcept
+            {
+                if (auto result = this->result(); !result) {
+                    return unexpected(result.error());
+                }
+
+                return {};
+            }
+
+        private:
+            std::atomic<void*>& slot() noexcept
+            {
+                return descriptor_.write_;
+            }
+
+            bool perform() noexcept
+            {
+                return this->complete(
+                    __connect(descriptor_.fd_, endpoint_, started_));
+            }
+
+            __io_detail::__descriptor& descriptor_;
+            ipv4_endpoint endpoint_;
+            bool started_ = false;
+        };
+
+        IRIS_ASSERT(is_open());
+        return awaitable(*descriptor_, endpoint);
+    }
+
+private:
+    static long __read(int fd, std::byte* data, std::size_t size) noexcept;
+
+    static long
+    __write(int fd, const std::byte* data, std::size_t size) noexcept;
+
+    static long
+    __connect(int fd, const ipv4_endpoint& endpoint, bool& started) noexcept;
+
+    io_context* context_;
+    __io_detail::__descriptor* descriptor_ = nullptr;
+};
+
+class acceptor {
+public:
+    explicit acceptor(io_context& context) noexcept
+        : context_(context)
+    {
+    }
+
+    acceptor(const acceptor&) = delete;
+
+    acceptor& operator=(const acceptor&) = delete;
+
+    ~acceptor() noexcept = default;
+
+    expected<void, std::error_code> listen(const ipv4_endpoint& endpoint,
+                                           int backlog = 128);
+
+    void close() noexcept
+    {
+        socket_.reset();
+    }
+
+    expected<ipv4_endpoint, std::error_code> local_endpoint() const noexcept
+    {
+        return socket_ ? socket_->local_endpoint() : unexpected(
+                   std::make_error_code(std::errc::bad_file_descriptor));
+    }
+
+    auto async_accept() noexcept
+    {
+        class awaitable : public __io_detail::__reactor_awaitable<awaitable> {
+            friend class __io_detail::__reactor_awaitable<awaitable>;
+
+        public:
+            awaitable(io_context& context,
+                      __io_detail::__descriptor& descriptor) noexcept
+                : context_(context)
+                , descriptor_(descriptor)
+            {
+            }
+
+            expected<socket, std::error_code> await_resume()
+            {
+                auto result = this->result();
+                if (!result) {
+                    return unexpected(result.error());
+                }
+
+                return socket(context_, static_cast<int>(*result));
+            }
+
+        private:
+            std::atomic<void*>& slot() noexcept
+            {
+                return descriptor_.read_;
+            }
+
+            bool perform() noexcept
+            {
+                return this->complete(__accept(descriptor_.fd_));
+            }
+
+            io_context& context_;
+            __io_detail::__descriptor& descriptor_;
+        };
+
+        IRIS_ASSERT(socket_);
+        return awaitable(context_, *socket_->descriptor_);
+    }
+
+private:
+    static long __accept(int fd) noexcept;
+
+    io_context& context_;
+    std::optional<socket> socket_;
+};
+
+}
+
+#endif
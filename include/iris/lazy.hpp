@@ -2,9 +2,17 @@
 
 #include <iris/config.hpp>
 
+#include <iris/__detail/frame_allocator.hpp>
+#include <iris/__detail/promise_result.hpp>
 #include <iris/__detail/sync_wait.hpp>
+#include <iris/expected.hpp>
+#include <iris/type_traits.hpp>
+#if defined(IRIS_ENABLE_TRACING)
+#include <iris/trace.hpp>
+#endif
 
 #include <coroutine>
+#include <memory>
 #include <type_traits>
 
 namespace iris {
@@ -13,43 +21,94 @@ template <typename T = void>
 class lazy;
 
 namespace __lazy_detail {
-    template <typename T>
-    class __lazy_promise_type_base {
+    template <typename T, typename Expected>
+    class __expected_awaitable;
+
+    // whether `co_await` on `Expected` in a `lazy<T>` completes the coroutine
+    // with the error of `Expected`.
+    // clang-format off
+    template <typename T, typename Expected>
+    concept __propagates_error =
+        is_specialization_of_v<T, expected>
+        && is_specialization_of_v<std::remove_cvref_t<Expected>, expected>
+        && std::constructible_from<
+            typename T::error_type,
+            decltype(std::declval<Expected>().error())>;
+    // clang-format on
+
+    // forwards to the awaiter of `Awaitable`. gcc 12 copies an awaitable
+    // which `await_transform` returns by reference into the frame, so the
+    // awaitables passed through are wrapped instead.
+    template <typename Awaitable>
+    class __forwarding_awaitable {
+        template <typename U>
+        static decltype(auto) __get_awaiter(U&& u)
+        {
+            if constexpr (requires {
+                              std::forward<U>(u).operator co_await();
+                          }) {
+                return std::forward<U>(u).operator co_await();
+            } else if constexpr (requires {
+                                     operator co_await(std::forward<U>(u));
+                                 }) {
+                return operator co_await(std::forward<U>(u));
+            } else {
+                return std::forward<U>(u);
+            }
+        }
+
+        using awaiter_type
+            = decltype(__get_awaiter(std::declval<Awaitable>()));
+
     public:
-        void return_value(T value)
+        explicit __forwarding_awaitable(Awaitable&& awaitable)
+            : awaiter_(__get_awaiter(std::forward<Awaitable>(awaitable)))
         {
-            value_ = std::move(value);
         }
 
-        T result()
+        bool await_ready()
         {
-            return std::move(value_);
+            return awaiter_.await_ready();
         }
 
-    private:
-        T value_;
-    };
+        template <typename Promise>
+        decltype(auto) await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            return awaiter_.await_suspend(handle);
+        }
 
-    template <>
-    class __lazy_promise_type_base<void> {
-    public:
-        void return_void() noexcept { }
+        decltype(auto) await_resume()
+        {
+            return awaiter_.await_resume();
+        }
 
-        void result() noexcept { }
+    private:
+        awaiter_type awaiter_;
     };
 
     template <typename T>
-    class __lazy_promise_type : public __lazy_promise_type_base<T> {
+    class __lazy_promise_type : public __detail::__promise_result<T> {
     public:
+        __lazy_promise_type() noexcept
+        {
+            IRIS_TRACE(create, __frame(), "lazy");
+        }
+
         lazy<T> get_return_object();
 
         auto initial_suspend() noexcept
         {
+#if defined(IRIS_ENABLE_TRACING)
+            return __detail::__traced_initial_suspend("lazy");
+#else
             return std::suspend_always();
+#endif
         }
 
         auto final_suspend() noexcept
         {
+            IRIS_TRACE(complete, __frame(), "lazy");
+
             class awaitable {
             public:
                 awaitable(std::coroutine_handle<> continuation)
@@ -75,17 +134,46 @@ namespace __lazy_detail {
             return awaitable(continuation_);
         }
 
-        void unhandled_exception() noexcept
+        void set_continuation(std::coroutine_handle<> continuation) noexcept
         {
-            std::terminate();
+            continuation_ = continuation;
         }
 
-        void set_continuation(std::coroutine_handle<> continuation) noexcept
+        std::coroutine_handle<> continuation() const noexcept
         {
-            continuation_ = continuation;
+            return continuation_;
+        }
+
+        // inside a `lazy<expected<U, E>>`, `co_await` on an `expected`
+        // holding an error completes the coroutine with that error right
+        // away, without unwinding through an exception. a value is
+        // unwrapped. the coroutine stays suspended at that point, so its
+        // locals are only destroyed with the `lazy`.
+        template <typename Awaitable>
+        auto await_transform(Awaitable&& awaitable)
+        {
+            if constexpr (__propagates_error<T, Awaitable>) {
+                return __expected_awaitable<T, Awaitable>(
+                    std::forward<Awaitable>(awaitable), *this);
+            } else {
+#if defined(IRIS_ENABLE_TRACING)
+                return __detail::__traced_awaitable<Awaitable>(
+                    std::forward<Awaitable>(awaitable), "lazy");
+#else
+                return __forwarding_awaitable<Awaitable>(
+                    std::forward<Awaitable>(awaitable));
+#endif
+            }
         }
 
     private:
+        void* __frame() noexcept
+        {
+            return std::coroutine_handle<__lazy_promise_type>::from_promise(
+                       *this)
+                .address();
+        }
+
         std::coroutine_handle<> continuation_;
     };
 }
@@ -99,7 +187,7 @@ public:
     using value_type = T;
 
     lazy(lazy&& other) noexcept
-        : handle_(std::exchange(other.handle_))
+        : handle_(std::exchange(other.handle_, {}))
     {
     }
 
@@ -130,7 +218,7 @@ public:
                 return handle_;
             }
 
-            auto await_resume() noexcept
+            auto await_resume()
             {
                 return handle_.promise().result();
             }
@@ -143,8 +231,9 @@ public:
 
     T sync_wait()
     {
+        run_loop loop;
         auto task = __detail::__sync_wait_impl(*this);
-        task.start();
+        task.start(loop);
         return task.result();
     }
 
@@ -158,11 +247,99 @@ private:
 };
 
 namespace __lazy_detail {
+    template <typename T, typename Expected>
+    class __expected_awaitable {
+    public:
+        using value_type = typename std::remove_cvref_t<Expected>::value_type;
+
+        __expected_awaitable(Expected&& exp,
+                             __lazy_promise_type<T>& promise) noexcept
+            : exp_(std::forward<Expected>(exp))
+            , promise_(promise)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return exp_.has_value();
+        }
+
+        std::coroutine_handle<>
+        await_suspend([[maybe_unused]] std::coroutine_handle<> handle)
+        {
+            promise_.return_value(
+                T(unexpect, std::forward<Expected>(exp_).error()));
+            IRIS_TRACE(complete, handle.address(), "lazy");
+            return promise_.continuation();
+        }
+
+        decltype(auto) await_resume()
+        {
+            if constexpr (std::is_void_v<value_type>) {
+                return;
+            } else if constexpr (std::is_lvalue_reference_v<Expected>) {
+                return *exp_;
+            } else {
+                return value_type(*std::move(exp_));
+            }
+        }
+
+    private:
+        Expected&& exp_;
+        __lazy_promise_type<T>& promise_;
+    };
+
     template <typename T>
     lazy<T> __lazy_promise_type<T>::get_return_object()
     {
         return std::coroutine_handle<__lazy_promise_type<T>>::from_promise(
             *this);
     }
+
+    // the promise of the coroutines taking `std::allocator_arg`, selected by
+    // `std::coroutine_traits` so that only their frames pay for the erased
+    // allocator. it adds no members, the frame is accessed as the frame of a
+    // `__lazy_promise_type<T>`.
+    template <typename T>
+    class __lazy_allocator_promise_type : public __lazy_promise_type<T> {
+    public:
+        template <typename Alloc, typename... Args>
+        static void* operator new(std::size_t size,
+                                  std::allocator_arg_t,
+                                  Alloc&& alloc,
+                                  Args&...)
+        {
+            return __detail::__erased_frame_allocator::allocate(
+                std::forward<Alloc>(alloc), size);
+        }
+
+        template <typename This, typename Alloc, typename... Args>
+        static void* operator new(std::size_t size,
+                                  This&,
+                                  std::allocator_arg_t,
+                                  Alloc&& alloc,
+                                  Args&...)
+        {
+            return __detail::__erased_frame_allocator::allocate(
+                std::forward<Alloc>(alloc), size);
+        }
+
+        static void operator delete(void* pointer, std::size_t size)
+        {
+            __detail::__erased_frame_allocator::deallocate(pointer, size);
+        }
+    };
+}
 }
+
+namespace std {
+template <typename T, typename Alloc, typename... Args>
+struct coroutine_traits<iris::lazy<T>, allocator_arg_t, Alloc, Args...> {
+    using promise_type = iris::__lazy_detail::__lazy_allocator_promise_type<T>;
+};
+
+template <typename T, typename This, typename Alloc, typename... Args>
+struct coroutine_traits<iris::lazy<T>, This, allocator_arg_t, Alloc, Args...> {
+    using promise_type = iris::__lazy_detail::__lazy_allocator_promise_type<T>;
+};
 }
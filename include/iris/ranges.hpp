@@ -4,20 +4,29 @@
 
 #include <iris/ranges/elements_of.hpp>
 #include <iris/ranges/range_adaptor_closure.hpp>
+#include <iris/ranges/segments.hpp>
 #include <iris/ranges/to.hpp>
 
+#include <iris/ranges/view/adjacent_span_view.hpp>
 #include <iris/ranges/view/adjacent_transform_view.hpp>
 #include <iris/ranges/view/adjacent_view.hpp>
 #include <iris/ranges/view/as_rvalue_view.hpp>
 #include <iris/ranges/view/base64_view.hpp>
+#include <iris/ranges/view/cache_latest_view.hpp>
 #include <iris/ranges/view/cartesian_product_view.hpp>
+#include <iris/ranges/view/chunk_by_sorted_view.hpp>
 #include <iris/ranges/view/chunk_by_view.hpp>
+#include <iris/ranges/view/chunk_exact_view.hpp>
 #include <iris/ranges/view/chunk_view.hpp>
+#include <iris/ranges/view/concat_ranges_view.hpp>
 #include <iris/ranges/view/concat_view.hpp>
 #include <iris/ranges/view/enumerate_view.hpp>
 #include <iris/ranges/view/join_with_view.hpp>
+#include <iris/ranges/view/memoize_view.hpp>
+#include <iris/ranges/view/prefetch_view.hpp>
 #include <iris/ranges/view/repeat_view.hpp>
 #include <iris/ranges/view/slide_view.hpp>
+#include <iris/ranges/view/split_view.hpp>
 #include <iris/ranges/view/stride_view.hpp>
 #include <iris/ranges/view/unwrap_view.hpp>
 #include <iris/ranges/view/utf_view.hpp>
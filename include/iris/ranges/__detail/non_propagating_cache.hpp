@@ -21,8 +21,9 @@ public:
         }
     }
 
-    constexpr __non_propagating_cache(
-        const __non_propagating_cache&) noexcept = default;
+    constexpr __non_propagating_cache(const __non_propagating_cache&) noexcept
+    {
+    }
 
     constexpr __non_propagating_cache(__non_propagating_cache&& other)
     {
@@ -36,10 +37,7 @@ public:
     operator=(const __non_propagating_cache& other)
     {
         if (std::addressof(other) != this) {
-            if (other.has_) {
-                other.value_.~T();
-                other.has_ = false;
-            }
+            reset();
         }
 
         return *this;
@@ -48,15 +46,8 @@ public:
     constexpr __non_propagating_cache&
     operator=(__non_propagating_cache&& other)
     {
-        if (has_) {
-            value_.~T();
-            has_ = false;
-        }
-
-        if (other.has_) {
-            other.value_.~T();
-            other.has_ = false;
-        }
+        reset();
+        other.reset();
 
         return *this;
     };
@@ -73,13 +64,23 @@ public:
         return value_;
     }
 
-    template <typename... Args>
-    constexpr T& emplace(Args&&... args)
+    constexpr bool has_value() const noexcept
+    {
+        return has_;
+    }
+
+    constexpr void reset() noexcept
     {
         if (has_) {
             value_.~T();
             has_ = false;
         }
+    }
+
+    template <typename... Args>
+    constexpr T& emplace(Args&&... args)
+    {
+        reset();
 
         std::construct_at(&value_, std::forward<Args>(args)...);
         has_ = true;
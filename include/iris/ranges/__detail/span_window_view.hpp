@@ -0,0 +1,205 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/utility.hpp>
+
+#include <compare>
+#include <span>
+
+namespace iris::ranges::__detail {
+
+// the windows of `N` elements of a contiguous range whose starts are
+// `Stride` elements apart, as `std::span<T, N>`s, so that an iterator is a
+// single pointer. there are no partial windows: a range of `n >= N` elements
+// has `(n - N) / Stride + 1` windows, and a shorter range has none. this is
+// the common base of `chunk_exact_view` and `adjacent_span_view`.
+template <typename Derived, typename View, std::size_t N, std::size_t Stride>
+    requires std::ranges::contiguous_range<View> && std::ranges::
+        sized_range<View> &&(N > 0 && N != std::dynamic_extent && Stride > 0)
+class __span_window_view : public std::ranges::view_interface<Derived> {
+public:
+    template <bool Const>
+    class iterator {
+        friend class __span_window_view;
+        friend class iterator<!Const>;
+
+        using Base = __maybe_const<Const, View>;
+        using element_type
+            = std::remove_reference_t<std::ranges::range_reference_t<Base>>;
+
+        static constexpr auto stride
+            = static_cast<std::ranges::range_difference_t<Base>>(Stride);
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::span<element_type, N>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+
+        constexpr iterator(iterator<!Const> other) requires(
+            Const&& std::convertible_to<std::ranges::iterator_t<View>,
+                                        std::ranges::iterator_t<Base>>)
+            : current_(other.current_)
+        {
+        }
+
+        constexpr value_type operator*() const
+        {
+            return value_type(current_, N);
+        }
+
+        constexpr iterator& operator++()
+        {
+            current_ += stride;
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator--()
+        {
+            current_ -= stride;
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator+=(difference_type offset)
+        {
+            current_ += offset * stride;
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type offset)
+        {
+            return *this += -offset;
+        }
+
+        constexpr value_type operator[](difference_type offset) const
+        {
+            return *(*this + offset);
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+            = default;
+
+        friend constexpr auto operator<=>(const iterator& lhs,
+                                          const iterator& rhs)
+            = default;
+
+        friend constexpr iterator operator+(const iterator& i,
+                                            difference_type offset)
+        {
+            auto r = i;
+            r += offset;
+            return r;
+        }
+
+        friend constexpr iterator operator+(difference_type offset,
+                                            const iterator& i)
+        {
+            return i + offset;
+        }
+
+        friend constexpr iterator operator-(const iterator& i,
+                                            difference_type offset)
+        {
+            auto r = i;
+            r -= offset;
+            return r;
+        }
+
+        friend constexpr difference_type operator-(const iterator& lhs,
+                                                   const iterator& rhs)
+        {
+            return (lhs.current_ - rhs.current_) / stride;
+        }
+
+    private:
+        constexpr explicit iterator(element_type* current)
+            : current_(current)
+        {
+        }
+
+        element_type* current_ = nullptr;
+    };
+
+    __span_window_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit __span_window_view(View base)
+        : base_(std::move(base))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr auto begin() requires(!__simple_view<View>)
+    {
+        return iterator<false>(std::ranges::data(base_));
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::contiguous_range<const View>
+    {
+        return iterator<true>(std::ranges::data(base_));
+    }
+
+    constexpr auto end() requires(!__simple_view<View>)
+    {
+        return iterator<false>(std::ranges::data(base_) + size() * Stride);
+    }
+
+    constexpr auto end() const
+        requires std::ranges::contiguous_range<const View>
+    {
+        return iterator<true>(std::ranges::data(base_) + size() * Stride);
+    }
+
+    constexpr std::size_t size()
+    {
+        return __size(static_cast<std::size_t>(std::ranges::size(base_)));
+    }
+
+    constexpr std::size_t size() const
+        requires std::ranges::sized_range<const View>
+    {
+        return __size(static_cast<std::size_t>(std::ranges::size(base_)));
+    }
+
+#if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
+    void __placeholder();
+#endif
+
+protected:
+    View base_ {};
+
+private:
+    static constexpr std::size_t __size(std::size_t size) noexcept
+    {
+        return size < N ? 0 : (size - N) / Stride + 1;
+    }
+};
+}
@@ -97,6 +97,14 @@ template <typename Fn, typename T, std::size_t N>
 using __invoke_result_repeat_n_t =
     typename __invoke_result_repeat_n<Fn, T, N>::type;
 
+// binds an element to an lvalue, whether it is an lvalue or an rvalue
+// reference.
+template <typename T>
+constexpr T& __as_lvalue(T&& t) noexcept
+{
+    return static_cast<T&>(t);
+}
+
 template <typename T>
 constexpr T __div_ceil(T num, T denom) noexcept
 {
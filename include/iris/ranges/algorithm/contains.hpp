@@ -2,6 +2,8 @@
 
 #include <iris/config.hpp>
 
+#include <iris/ranges/segments.hpp>
+
 #include <ranges>
 
 namespace iris::ranges {
@@ -25,9 +27,24 @@ struct __contains_fn {
     const T* > constexpr bool
         operator()(R&& r, const T& value, Proj proj = {}) const
     {
-        return (*this)(std::ranges::begin(std::forward<R>(r)),
-                       std::ranges::end(std::forward<R>(r)), value,
-                       std::move(proj));
+        if constexpr (segmented_range<R>) {
+            // searches each segment in a loop of its own.
+            return !ranges::segments(r, [&](auto& segment, auto) {
+                for (auto&& element : segment) {
+                    if (std::invoke(proj, __segments_detail::__element<R>(
+                                              std::forward<decltype(element)>(
+                                                  element)))
+                        == value) {
+                        return false;
+                    }
+                }
+                return true;
+            });
+        } else {
+            return (*this)(std::ranges::begin(std::forward<R>(r)),
+                           std::ranges::end(std::forward<R>(r)), value,
+                           std::move(proj));
+        }
     }
 };
 
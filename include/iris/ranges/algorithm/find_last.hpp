@@ -2,6 +2,8 @@
 
 #include <iris/config.hpp>
 
+#include <iris/ranges/segments.hpp>
+
 #include <functional>
 #include <optional>
 #include <ranges>
@@ -37,6 +39,65 @@ namespace __find_last_detail {
 
         return { last, last };
     }
+
+    template <typename I, typename S, typename Pred>
+    constexpr std::optional<I> find_last_in(I first, S last, Pred& pred)
+    {
+        if constexpr (std::bidirectional_iterator<I> && std::same_as<I, S>) {
+            for (auto curr = last; curr != first;) {
+                if (pred(*--curr)) {
+                    return curr;
+                }
+            }
+            return std::nullopt;
+        } else {
+            std::optional<I> found;
+            for (; first != last; ++first) {
+                if (pred(*first)) {
+                    found = first;
+                }
+            }
+            return found;
+        }
+    }
+
+    // a bidirectional common range is searched backward from its end, which
+    // stops at the last match rather than visiting every segment.
+    // clang-format off
+    template <typename R>
+    concept __segmented_common = segmented_range<R>
+        && std::ranges::common_range<R>
+        && !std::ranges::bidirectional_range<R>;
+    // clang-format on
+
+    // searches each segment of `r` in a loop of its own.
+    template <typename R, typename Pred, typename Proj>
+    constexpr std::ranges::subrange<std::ranges::iterator_t<R>>
+    find_last_segments(R& r, Pred& pred, Proj& proj)
+    {
+        std::optional<std::ranges::iterator_t<R>> found;
+        ranges::segments(r, [&](auto& segment, auto position) {
+            auto matches = [&](auto&& element) -> bool {
+                return std::invoke(
+                    pred,
+                    std::invoke(proj,
+                                __segments_detail::__element<R>(
+                                    std::forward<decltype(element)>(element))));
+            };
+            if (auto it = find_last_in(std::ranges::begin(segment),
+                                         std::ranges::end(segment), matches)) {
+                found = position(std::move(*it));
+            }
+            return true;
+        });
+
+        auto last = std::ranges::end(r);
+        if (found) {
+            return { std::move(*found), last };
+        } else {
+            return { last, last };
+        }
+    }
 }
 
 struct __find_last_fn {
@@ -62,9 +123,14 @@ struct __find_last_fn {
     const T* > constexpr std::ranges::borrowed_subrange_t<R>
         operator()(R&& r, const T& value, Proj proj = {}) const
     {
-        return (*this)(std::ranges::begin(std::forward<R>(r)),
-                       std::ranges::end(std::forward<R>(r)), value,
-                       std::move(proj));
+        if constexpr (__find_last_detail::__segmented_common<R>) {
+            auto pred = [&value](const auto& input) { return value == input; };
+            return __find_last_detail::find_last_segments(r, pred, proj);
+        } else {
+            return (*this)(std::ranges::begin(std::forward<R>(r)),
+                           std::ranges::end(std::forward<R>(r)), value,
+                           std::move(proj));
+        }
     }
 };
 
@@ -90,9 +156,13 @@ struct __find_last_if_fn {
     constexpr std::ranges::borrowed_subrange_t<R>
     operator()(R&& r, Pred pred, Proj proj = {}) const
     {
-        return (*this)(std::ranges::begin(std::forward<R>(r)),
-                       std::ranges::end(std::forward<R>(r)), std::move(pred),
-                       std::move(proj));
+        if constexpr (__find_last_detail::__segmented_common<R>) {
+            return __find_last_detail::find_last_segments(r, pred, proj);
+        } else {
+            return (*this)(std::ranges::begin(std::forward<R>(r)),
+                           std::ranges::end(std::forward<R>(r)),
+                           std::move(pred), std::move(proj));
+        }
     }
 };
 
@@ -120,9 +190,16 @@ struct __find_last_if_not_fn {
     constexpr std::ranges::borrowed_subrange_t<R>
     operator()(R&& r, Pred pred, Proj proj = {}) const
     {
-        return (*this)(std::ranges::begin(std::forward<R>(r)),
-                       std::ranges::end(std::forward<R>(r)), std::move(pred),
-                       std::move(proj));
+        if constexpr (__find_last_detail::__segmented_common<R>) {
+            auto not_pred = [&pred](auto&& value) {
+                return !std::invoke(pred, std::forward<decltype(value)>(value));
+            };
+            return __find_last_detail::find_last_segments(r, not_pred, proj);
+        } else {
+            return (*this)(std::ranges::begin(std::forward<R>(r)),
+                           std::ranges::end(std::forward<R>(r)),
+                           std::move(pred), std::move(proj));
+        }
     }
 };
 
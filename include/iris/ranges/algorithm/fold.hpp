@@ -3,7 +3,10 @@
 #include <iris/config.hpp>
 
 #include <iris/ranges/algorithm/base.hpp>
+#include <iris/ranges/segments.hpp>
 
+#include <functional>
+#include <optional>
 #include <ranges>
 
 namespace iris::ranges {
@@ -117,8 +120,48 @@ struct __fold_left_fn {
                   std::ranges::iterator_t<R>> F>
     constexpr auto operator()(R&& r, T init, F f) const
     {
-        return fold_left_with_iter(std::forward<R>(r), std::move(init), f)
-            .value;
+        if constexpr (segmented_range<R>) {
+            return __fold_segments(r, std::move(init), f);
+        } else {
+            return fold_left_with_iter(std::forward<R>(r), std::move(init), f)
+                .value;
+        }
+    }
+
+private:
+    // folds each segment of `r` in a loop of its own.
+    template <typename R, typename T, typename F>
+    static constexpr auto __fold_segments(R& r, T init, F& f)
+    {
+        using U = std::decay_t<
+            std::invoke_result_t<F&, T, std::ranges::range_reference_t<R>>>;
+
+        std::optional<U> accum;
+        ranges::segments(r, [&](auto& segment, auto) {
+            auto first = std::ranges::begin(segment);
+            auto last = std::ranges::end(segment);
+            if (!accum) {
+                if (first == last) {
+                    return true;
+                }
+                accum.emplace(std::invoke(
+                    f, std::move(init),
+                    __segments_detail::__element<R>(*first)));
+                ++first;
+            }
+
+            auto& value = *accum;
+            for (; first != last; ++first) {
+                value = std::invoke(f, std::move(value),
+                                    __segments_detail::__element<R>(*first));
+            }
+            return true;
+        });
+
+        if (!accum) {
+            return U(std::move(init));
+        }
+        return std::move(*accum);
     }
 };
 
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iris::ranges::par {
+namespace __parallel_detail {
+    template <typename Scheduler>
+    concept __scheduler = requires(Scheduler& s)
+    {
+        s.schedule();
+    };
+
+    template <typename Range>
+    concept __parallel_range = std::ranges::random_access_range<
+        Range> && std::ranges::sized_range<Range>;
+
+    class __detached {
+    public:
+        class promise_type {
+        public:
+            __detached get_return_object() noexcept
+            {
+                return {};
+            }
+
+            auto initial_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            auto final_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            void return_void() noexcept { }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    // splits `[0, chunks)` evenly among the workers. each worker takes
+    // chunks from the front of its own share, and once it runs out, steals
+    // the back half of the share of another worker.
+    template <typename Job>
+    class __state {
+    public:
+        __state(Job job, std::size_t chunks, std::size_t workers)
+            : job_(std::move(job))
+            , shares_(workers)
+            , remaining_(chunks)
+        {
+            for (std::size_t i = 0; i < workers; ++i) {
+                shares_[i].range_.store(
+                    __pack(chunks * i / workers, chunks * (i + 1) / workers),
+                    std::memory_order_relaxed);
+            }
+        }
+
+        void run(std::size_t worker) noexcept
+        {
+            for (;;) {
+                auto chunk = __pop(worker);
+                if (!chunk && !__steal(worker)) {
+                    return;
+                }
+                if (chunk) {
+                    __execute(*chunk);
+                }
+            }
+        }
+
+        // waits for all chunks to be executed, and rethrows the first
+        // exception thrown by them.
+        void wait()
+        {
+            auto remaining = remaining_.load(std::memory_order_acquire);
+            while (remaining != 0) {
+                remaining_.wait(remaining, std::memory_order_acquire);
+                remaining = remaining_.load(std::memory_order_acquire);
+            }
+
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+        }
+
+    private:
+        struct alignas(64) __share {
+            std::atomic<std::uint64_t> range_;
+        };
+
+        static std::uint64_t __pack(std::uint64_t first,
+                                    std::uint64_t last) noexcept
+        {
+            return (first << 32) | last;
+        }
+
+        static std::pair<std::size_t, std::size_t>
+        __unpack(std::uint64_t range) noexcept
+        {
+            return { static_cast<std::size_t>(range >> 32),
+                     static_cast<std::size_t>(range & 0xffffffff) };
+        }
+
+        std::optional<std::size_t> __pop(std::size_t worker) noexcept
+        {
+            auto& range = shares_[worker].range_;
+            auto value = range.load(std::memory_order_relaxed);
+            for (;;) {
+                auto [first, last] = __unpack(value);
+                if (first >= last) {
+                    return std::nullopt;
+                }
+                if (range.compare_exchange_weak(value, __pack(first + 1, last),
+                                                std::memory_order_relaxed)) {
+                    return first;
+                }
+            }
+        }
+
+        bool __steal(std::size_t worker) noexcept
+        {
+            for (std::size_t i = 1; i < shares_.size(); ++i) {
+                auto& range = shares_[(worker + i) % shares_.size()].range_;
+                auto value = range.load(std::memory_order_relaxed);
+                for (;;) {
+                    auto [first, last] = __unpack(value);
+                    if (first >= last) {
+                        break;
+                    }
+                    auto middle = last - (last - first + 1) / 2;
+                    if (range.compare_exchange_weak(
+                            value, __pack(first, middle),
+                            std::memory_order_relaxed)) {
+                        shares_[worker].range_.store(
+                            __pack(middle, last), std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void __execute(std::size_t chunk) noexcept
+        {
+            if (!failed_.load(std::memory_order_relaxed)) {
+                try {
+                    job_(chunk);
+                } catch (...) {
+                    if (!failed_.exchange(true, std::memory_order_relaxed)) {
+                        exception_ = std::current_exception();
+                    }
+                }
+            }
+
+            if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                remaining_.notify_all();
+            }
+        }
+
+        Job job_;
+        std::vector<__share> shares_;
+        std::atomic<std::size_t> remaining_;
+        std::atomic<bool> failed_ { false };
+        std::exception_ptr exception_;
+    };
+
+    template <typename Scheduler, typename State>
+    __detached __worker(Scheduler& scheduler,
+                        std::shared_ptr<State> state,
+                        std::size_t worker)
+    {
+        co_await scheduler.schedule();
+        state->run(worker);
+    }
+
+    template <typename Scheduler>
+    std::size_t __concurrency(Scheduler& scheduler) noexcept
+    {
+        if constexpr (requires { scheduler.size(); }) {
+            return std::max<std::size_t>(1, scheduler.size());
+        } else {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    // the number of elements per chunk, so that the elements of a chunk
+    // fit into the L1 cache while leaving a few chunks per worker to
+    // balance the load.
+    template <typename Range>
+    std::size_t __chunk_size(std::size_t size, std::size_t workers) noexcept
+    {
+        constexpr std::size_t cache_size = 32 * 1024;
+        constexpr std::size_t element_size = std::max<std::size_t>(
+            1, sizeof(std::ranges::range_value_t<Range>));
+        return std::clamp<std::size_t>(
+            (size + workers * 4 - 1) / (workers * 4), 1,
+            std::max<std::size_t>(1, cache_size / element_size));
+    }
+
+    // runs `job(chunk, first, last)` for each chunk `[first, last)` of
+    // `[0, size)` on `scheduler` and the calling thread, and blocks until all
+    // of them have completed.
+    template <typename Scheduler, typename Job>
+    void __parallel(Scheduler& scheduler,
+                    std::size_t size,
+                    std::size_t chunk_size,
+                    Job job)
+    {
+        if (size == 0) {
+            return;
+        }
+
+        auto chunks = (size + chunk_size - 1) / chunk_size;
+        auto workers = std::min(__concurrency(scheduler), chunks);
+        auto run_chunk = [job = std::move(job), size,
+                          chunk_size](std::size_t chunk) {
+            auto first = chunk * chunk_size;
+            job(chunk, first, std::min(first + chunk_size, size));
+        };
+
+        using state_type = __state<decltype(run_chunk)>;
+        auto state = std::make_shared<state_type>(std::move(run_chunk),
+                                                  chunks, workers);
+        for (std::size_t i = 1; i < workers; ++i) {
+            __worker(scheduler, state, i);
+        }
+        state->run(0);
+        state->wait();
+    }
+}
+
+struct __for_each_fn {
+    // invokes `f` on each element of `r` in parallel.
+    template <__parallel_detail::__scheduler Scheduler,
+              __parallel_detail::__parallel_range R,
+              typename F>
+        requires std::invocable<F&, std::ranges::range_reference_t<R>>
+    void operator()(Scheduler& scheduler, R&& r, F f) const
+    {
+        auto first = std::ranges::begin(r);
+        auto size = static_cast<std::size_t>(std::ranges::size(r));
+        __parallel_detail::__parallel(
+            scheduler, size,
+            __parallel_detail::__chunk_size<R>(
+                size, __parallel_detail::__concurrency(scheduler)),
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+                auto it = first + begin;
+                for (auto i = begin; i < end; ++i, ++it) {
+                    std::invoke(f, *it);
+                }
+            });
+    }
+};
+
+inline constexpr __for_each_fn for_each {};
+
+struct __transform_fn {
+    // writes `f(e)` for each element `e` of `r` into the range starting at
+    // `result` in parallel, returns the end of the written range.
+    // clang-format off
+    template <__parallel_detail::__scheduler Scheduler,
+              __parallel_detail::__parallel_range R,
+              std::random_access_iterator O,
+              typename F>
+        requires std::indirectly_writable<
+            O, std::indirect_result_t<F&, std::ranges::iterator_t<R>>>
+    // clang-format on
+    O operator()(Scheduler& scheduler, R&& r, O result, F f) const
+    {
+        auto first = std::ranges::begin(r);
+        auto size = static_cast<std::size_t>(std::ranges::size(r));
+        __parallel_detail::__parallel(
+            scheduler, size,
+            __parallel_detail::__chunk_size<R>(
+                size, __parallel_detail::__concurrency(scheduler)),
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+                auto it = first + begin;
+                auto out = result + begin;
+                for (auto i = begin; i < end; ++i, ++it, ++out) {
+                    *out = std::invoke(f, *it);
+                }
+            });
+        return result + size;
+    }
+};
+
+inline constexpr __transform_fn transform {};
+
+struct __fold_fn {
+    // folds each chunk of `r` with `f`, starting from a copy of `init`, then
+    // combines the results of the chunks in order with `combine`. `init`
+    // must be an identity of `combine`, and `combine` must be associative.
+    // clang-format off
+    template <__parallel_detail::__scheduler Scheduler,
+              __parallel_detail::__parallel_range R,
+              std::copy_constructible T,
+              typename F,
+              typename Combine>
+        requires std::invocable<F&, T, std::ranges::range_reference_t<R>>
+            && std::invocable<Combine&, T, T>
+    // clang-format on
+    T operator()(
+        Scheduler& scheduler, R&& r, T init, F f, Combine combine) const
+    {
+        auto first = std::ranges::begin(r);
+        auto size = static_cast<std::size_t>(std::ranges::size(r));
+        if (size == 0) {
+            return init;
+        }
+
+        auto chunk_size = __parallel_detail::__chunk_size<R>(
+            size, __parallel_detail::__concurrency(scheduler));
+        std::vector<std::optional<T>> partials((size + chunk_size - 1)
+                                               / chunk_size);
+        __parallel_detail::__parallel(
+            scheduler, size, chunk_size,
+            [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                T accum = init;
+                auto it = first + begin;
+                for (auto i = begin; i < end; ++i, ++it) {
+                    accum = std::invoke(f, std::move(accum), *it);
+                }
+                partials[chunk].emplace(std::move(accum));
+            });
+
+        T accum = std::move(*partials.front());
+        for (std::size_t i = 1; i < partials.size(); ++i) {
+            accum = std::invoke(combine, std::move(accum),
+                                std::move(*partials[i]));
+        }
+        return accum;
+    }
+};
+
+inline constexpr __fold_fn fold {};
+
+struct __reduce_fn {
+    // reduces `r` with the associative `op` in parallel, starting from
+    // `init`. the elements are combined in their order in `r`.
+    // clang-format off
+    template <__parallel_detail::__scheduler Scheduler,
+              __parallel_detail::__parallel_range R,
+              std::movable T,
+              typename Op = std::plus<>>
+        requires std::invocable<Op&, T, std::ranges::range_reference_t<R>>
+            && std::invocable<Op&, T, T>
+    // clang-format on
+    T operator()(Scheduler& scheduler, R&& r, T init, Op op = {}) const
+    {
+        auto first = std::ranges::begin(r);
+        auto size = static_cast<std::size_t>(std::ranges::size(r));
+        if (size == 0) {
+            return init;
+        }
+
+        auto chunk_size = __parallel_detail::__chunk_size<R>(
+            size, __parallel_detail::__concurrency(scheduler));
+        std::vector<std::optional<T>> partials((size + chunk_size - 1)
+                                               / chunk_size);
+        __parallel_detail::__parallel(
+            scheduler, size, chunk_size,
+            [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                auto it = first + begin;
+                T accum = static_cast<T>(*it);
+                for (auto i = begin + 1; i < end; ++i) {
+                    accum = std::invoke(op, std::move(accum), *++it);
+                }
+                partials[chunk].emplace(std::move(accum));
+            });
+
+        for (auto& partial : partials) {
+            init = std::invoke(op, std::move(init), std::move(*partial));
+        }
+        return init;
+    }
+};
+
+inline constexpr __reduce_fn reduce {};
+
+}
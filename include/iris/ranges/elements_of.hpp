@@ -4,10 +4,21 @@
 
 #include <ranges>
 
+namespace iris::__detail {
+
+// lets `elements_of` hold a type which is not a range, like
+// `async_generator`, specialized next to that type.
+template <typename T>
+inline constexpr bool __enable_elements_of = false;
+
+}
+
 namespace iris::ranges {
 
-template <std::ranges::range Range,
+template <typename Range,
           typename Allocator = std::allocator<std::byte>>
+    requires std::ranges::range<Range> || iris::__detail::__enable_elements_of<
+        std::remove_cvref_t<Range>>
 struct elements_of {
     Range range;
     Allocator allocator {};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <functional>
+#include <ranges>
+
+namespace iris::ranges {
+namespace __segments_detail {
+    struct __visitor {
+        template <typename Segment, typename Position>
+        bool operator()(Segment&, Position) const;
+    };
+}
+
+// a range made up of segments, each of which can be traversed by its own
+// iterators, e.g. the base ranges of `concat_view`.
+template <typename Range>
+concept segmented_range = std::ranges::range<Range> && requires(
+    Range& r, __segments_detail::__visitor& f)
+{
+    // clang-format off
+    { r.segments(f) } -> std::convertible_to<bool>;
+    // clang-format on
+};
+
+struct __segments_fn {
+    // invokes `f(segment, position)` on each segment of `r` in order until
+    // `f` returns false, and returns whether all of the segments have been
+    // visited. `position` maps a dereferenceable iterator of `segment` to the
+    // corresponding iterator of `r`. a range which is not segmented is a
+    // single segment of itself.
+    template <std::ranges::range R, typename F>
+    constexpr bool operator()(R&& r, F&& f) const
+    {
+        if constexpr (segmented_range<R>) {
+            return r.segments(f);
+        } else {
+            return static_cast<bool>(std::invoke(f, r, std::identity {}));
+        }
+    }
+};
+
+inline constexpr __segments_fn segments {};
+
+namespace __segments_detail {
+    // an element of a segment as seen through the iterators of `Range`.
+    template <typename Range, typename T>
+    constexpr std::ranges::range_reference_t<Range> __element(T&& element)
+    {
+        return std::forward<T>(element);
+    }
+}
+}
@@ -4,6 +4,7 @@
 
 #include <iris/bind.hpp>
 #include <iris/ranges/range_adaptor_closure.hpp>
+#include <iris/ranges/segments.hpp>
 #include <iris/type_traits.hpp>
 
 #include <algorithm>
@@ -38,6 +39,34 @@ namespace __to_detail {
             return std::inserter(c, std::ranges::end(c));
         }
     }
+
+    // appends `segment` of `Range` to `c`, as a whole if possible.
+    template <typename Range, typename C, typename Segment>
+    constexpr void __append_segment(C& c, Segment& segment)
+    {
+        // clang-format off
+        if constexpr (std::ranges::common_range<Segment> 
+            && std::same_as<
+                std::ranges::range_reference_t<Segment>, 
+                std::ranges::range_reference_t<Range>> 
+            && requires { 
+                c.insert(std::ranges::end(c), 
+                         std::ranges::begin(segment), 
+                         std::ranges::end(segment)); 
+            }) {
+            // clang-format on
+            c.insert(std::ranges::end(c), std::ranges::begin(segment),
+                     std::ranges::end(segment));
+        } else {
+            auto out = __container_inserter<
+                std::ranges::range_reference_t<Range>>(c);
+            for (auto&& element : segment) {
+                *out = __segments_detail::__element<Range>(
+                    std::forward<decltype(element)>(element));
+                ++out;
+            }
+        }
+    }
 }
 
 template <typename Container, std::ranges::input_range Range, typename... Args>
@@ -50,6 +79,23 @@ constexpr auto to(Range&& range, Args&&... args)
         if constexpr (std::constructible_from<Container, Range, Args...>) {
             return Container(std::forward<Range>(range),
                              std::forward<Args>(args)...);
+        } else if constexpr (segmented_range<Range>
+                             && __to_detail::__container_insertable<
+                                 Container,
+                                 std::ranges::range_reference_t<Range>>) {
+            // copies the segments one by one rather than going through the
+            // iterators of `range` element by element.
+            Container container(std::forward<Args>(args)...);
+            if constexpr (
+                std::ranges::sized_range<
+                    Range> && __to_detail::__container_reservable<Container>) {
+                container.reserve(std::ranges::size(range));
+            }
+            ranges::segments(range, [&](auto& segment, auto) {
+                __to_detail::__append_segment<Range>(container, segment);
+                return true;
+            });
+            return container;
             // clang-format off
         } else if constexpr (std::ranges::common_range<Range> 
             && std::constructible_from<
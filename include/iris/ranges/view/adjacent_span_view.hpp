@@ -0,0 +1,61 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/span_window_view.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+namespace iris::ranges {
+
+// the windows of `N` adjacent elements of a contiguous range, like
+// `adjacent_view`, but as `std::span<T, N>`s rather than tuples of references,
+// so that an iterator is a single pointer.
+template <std::ranges::view View, std::size_t N>
+    requires std::ranges::contiguous_range<View> && std::ranges::
+        sized_range<View> &&(N > 0 && N != std::dynamic_extent)
+class adjacent_span_view
+    : public __detail::
+          __span_window_view<adjacent_span_view<View, N>, View, N, 1> {
+    using Base = __detail::__span_window_view<adjacent_span_view, View, N, 1>;
+
+public:
+    adjacent_span_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit adjacent_span_view(View base)
+        : Base(std::move(base))
+    {
+    }
+};
+
+namespace views {
+    template <std::size_t N>
+    class __adjacent_span_fn
+        : public range_adaptor_closure<__adjacent_span_fn<N>> {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto operator()(Range&& range) const noexcept(
+            noexcept(adjacent_span_view<std::views::all_t<Range&&>, N>(
+                std::forward<Range>(range))))
+            -> decltype(adjacent_span_view<std::views::all_t<Range&&>, N>(
+                std::forward<Range>(range)))
+        {
+            return adjacent_span_view<std::views::all_t<Range&&>, N>(
+                std::forward<Range>(range));
+        }
+    };
+
+    template <std::size_t N>
+    inline constexpr __adjacent_span_fn<N> adjacent_span {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
+
+namespace std::ranges {
+template <class View, size_t N>
+inline constexpr bool enable_borrowed_range<
+    iris::ranges::adjacent_span_view<View, N>> = enable_borrowed_range<View>;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/non_propagating_cache.hpp>
+#include <iris/ranges/__detail/utility.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+namespace iris::ranges {
+
+// caches the element at the current position, so that it is computed once
+// however many times the iterator is dereferenced, e.g. by `views::filter`
+// over an expensive `views::transform`. the view is an input range.
+template <std::ranges::input_range View>
+    requires std::ranges::view<View>
+class cache_latest_view
+    : public std::ranges::view_interface<cache_latest_view<View>> {
+    using cache_type = std::conditional_t<
+        std::is_reference_v<std::ranges::range_reference_t<View>>,
+        std::add_pointer_t<std::ranges::range_reference_t<View>>,
+        std::ranges::range_reference_t<View>>;
+
+public:
+    class sentinel;
+
+    class iterator {
+        friend class cache_latest_view;
+        friend class sentinel;
+
+    public:
+        using difference_type = std::ranges::range_difference_t<View>;
+        using value_type = std::ranges::range_value_t<View>;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator(iterator&&) = default;
+
+        iterator& operator=(iterator&&) = default;
+
+        constexpr const std::ranges::iterator_t<View>& base() const& noexcept
+        {
+            return current_;
+        }
+
+        constexpr std::ranges::iterator_t<View> base() &&
+        {
+            return std::move(current_);
+        }
+
+        constexpr std::ranges::range_reference_t<View>& operator*() const
+        {
+            auto& cache = parent_->cache_;
+            if constexpr (std::is_reference_v<
+                              std::ranges::range_reference_t<View>>) {
+                if (!cache.has_value()) {
+                    cache.emplace(
+                        std::addressof(__detail::__as_lvalue(*current_)));
+                }
+                return **cache;
+            } else {
+                if (!cache.has_value()) {
+                    cache.emplace(*current_);
+                }
+                return *cache;
+            }
+        }
+
+        constexpr iterator& operator++()
+        {
+            parent_->cache_.reset();
+            ++current_;
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend constexpr std::ranges::range_rvalue_reference_t<View>
+        iter_move(const iterator& it) noexcept(
+            noexcept(std::ranges::iter_move(it.current_)))
+        {
+            return std::ranges::iter_move(it.current_);
+        }
+
+        friend constexpr void
+        iter_swap(const iterator& lhs, const iterator& rhs) noexcept(
+            noexcept(std::ranges::iter_swap(lhs.current_, rhs.current_)))
+            requires std::indirectly_swappable<std::ranges::iterator_t<View>>
+        {
+            std::ranges::iter_swap(lhs.current_, rhs.current_);
+        }
+
+    private:
+        constexpr explicit iterator(cache_latest_view& parent)
+            : parent_(std::addressof(parent))
+            , current_(std::ranges::begin(parent.base_))
+        {
+        }
+
+        cache_latest_view* parent_ = nullptr;
+        std::ranges::iterator_t<View> current_ {};
+    };
+
+    class sentinel {
+        friend class cache_latest_view;
+
+    public:
+        sentinel() = default;
+
+        constexpr std::ranges::sentinel_t<View> base() const
+        {
+            return end_;
+        }
+
+        friend constexpr bool operator==(const iterator& it,
+                                         const sentinel& s)
+        {
+            return s.__equal(it);
+        }
+
+        friend constexpr std::ranges::range_difference_t<View>
+        operator-(const iterator& it, const sentinel& s) requires
+            std::sized_sentinel_for<std::ranges::sentinel_t<View>,
+                                    std::ranges::iterator_t<View>>
+        {
+            return -s.__distance(it);
+        }
+
+        friend constexpr std::ranges::range_difference_t<View>
+        operator-(const sentinel& s, const iterator& it) requires
+            std::sized_sentinel_for<std::ranges::sentinel_t<View>,
+                                    std::ranges::iterator_t<View>>
+        {
+            return s.__distance(it);
+        }
+
+    private:
+        constexpr explicit sentinel(cache_latest_view& parent)
+            : end_(std::ranges::end(parent.base_))
+        {
+        }
+
+        constexpr bool __equal(const iterator& it) const
+        {
+            return it.current_ == end_;
+        }
+
+        constexpr std::ranges::range_difference_t<View>
+        __distance(const iterator& it) const
+        {
+            return end_ - it.current_;
+        }
+
+        std::ranges::sentinel_t<View> end_ {};
+    };
+
+    cache_latest_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit cache_latest_view(View base)
+        : base_(std::move(base))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr iterator begin()
+    {
+        cache_.reset();
+        return iterator(*this);
+    }
+
+    constexpr sentinel end()
+    {
+        return sentinel(*this);
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<View>
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<const View>
+    {
+        return std::ranges::size(base_);
+    }
+
+private:
+    View base_ {};
+    __detail::__non_propagating_cache<cache_type> cache_;
+};
+
+template <typename Range>
+cache_latest_view(Range&&) -> cache_latest_view<std::views::all_t<Range>>;
+
+namespace views {
+    class __cache_latest_fn
+        : public range_adaptor_closure<__cache_latest_fn> {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto operator()(Range&& range) const
+            noexcept(noexcept(cache_latest_view(std::forward<Range>(range))))
+                -> decltype(cache_latest_view(std::forward<Range>(range)))
+        {
+            return cache_latest_view(std::forward<Range>(range));
+        }
+    };
+
+    inline constexpr __cache_latest_fn cache_latest {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
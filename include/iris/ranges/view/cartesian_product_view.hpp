@@ -7,6 +7,7 @@
 #include <iris/utility.hpp>
 
 #include <array>
+#include <vector>
 
 namespace iris::ranges {
 namespace __cartesian_product_view_detail {
@@ -149,14 +150,8 @@ public:
                              __detail::__maybe_const<Const, First>,
                              __detail::__maybe_const<Const, Rests>...>)
         {
-            if (offset > 0) {
-                while (offset-- > 0) {
-                    next();
-                }
-            } else if (offset < 0) {
-                while (offset++ < 0) {
-                    prev();
-                }
+            if (offset != 0) {
+                advance(offset);
             }
             return *this;
         }
@@ -411,6 +406,34 @@ public:
             --it;
         }
 
+        // adds `offset` to the iterator of the `N`th base, and carries the
+        // quotient by its size over to the iterators of the preceding bases.
+        template <std::size_t N = pack_size_v<Rests...>>
+        constexpr void advance(difference_type offset)
+        {
+            auto& base = std::get<N>(parent_->bases_);
+            auto& it = std::get<N>(current_);
+            if constexpr (N == 0) {
+                it += offset;
+            } else {
+                const auto size
+                    = static_cast<difference_type>(std::ranges::size(base));
+                auto index = static_cast<difference_type>(
+                                 it - std::ranges::begin(base))
+                    + offset;
+                auto carry = index / size;
+                index %= size;
+                if (index < 0) {
+                    index += size;
+                    --carry;
+                }
+                it = std::ranges::begin(base) + index;
+                if (carry != 0) {
+                    advance<N - 1>(carry);
+                }
+            }
+        }
+
         template <class Tuple>
         difference_type distance_to(Tuple t) const
         {
@@ -533,11 +556,64 @@ public:
             bases_));
     }
 
+    // splits the product into `n` contiguous blocks, whose sizes differ by at
+    // most one, e.g. to traverse them on `n` threads. the iterators of the
+    // blocks start at positions computed once here, and step through the
+    // product like an odometer without any division.
+    // clang-format off
+    constexpr auto partition(std::size_t n)
+        requires (!__detail::__simple_view<First> || ...
+                  || !__detail::__simple_view<Rests>)
+            && __cartesian_product_view_detail::
+                __cartesian_product_is_random_access<First, Rests...>
+            && __cartesian_product_view_detail::
+                __cartesian_product_is_sized<First, Rests...>
+    // clang-format on
+    {
+        return __partition(*this, n);
+    }
+
+    // clang-format off
+    constexpr auto partition(std::size_t n) const
+        requires __cartesian_product_view_detail::
+                __cartesian_product_is_random_access<const First,
+                                                     const Rests...>
+            && __cartesian_product_view_detail::
+                __cartesian_product_is_sized<const First, const Rests...>
+    // clang-format on
+    {
+        return __partition(*this, n);
+    }
+
 #if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
     void __placeholder();
 #endif
 
 private:
+    template <typename Self>
+    static constexpr auto __partition(Self& self, std::size_t n)
+    {
+        IRIS_ASSERT(n > 0);
+        using iterator_type = decltype(self.begin());
+        using difference_type = typename iterator_type::difference_type;
+
+        const auto size = static_cast<std::size_t>(self.size());
+        const auto quotient = size / n;
+        const auto remainder = size % n;
+
+        std::vector<std::ranges::subrange<iterator_type>> blocks;
+        blocks.reserve(n);
+        auto first = self.begin();
+        for (std::size_t i = 0; i < n; ++i) {
+            auto last = first
+                + static_cast<difference_type>(quotient + (i < remainder));
+            blocks.emplace_back(first, last);
+            first = last;
+        }
+
+        return blocks;
+    }
+
     std::tuple<First, Rests...> bases_ {};
 };
 
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/bind.hpp>
+#include <iris/ranges/__detail/copyable_box.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace iris::ranges {
+
+// like `chunk_by_view`, but for a random access range whose chunks are runs,
+// that is, `pred(*first, *it)` holds for every `it` of a chunk starting at
+// `first`, and for none after it, e.g. `equal_to` over sorted elements. the
+// end of a chunk is found by a galloping search, which takes O(log m)
+// invocations of `pred` for a chunk of m elements. since a chunk is defined by
+// its first element, the chunks can only be found from the front, and the
+// view is a forward range.
+template <std::ranges::random_access_range View,
+          std::indirect_binary_predicate<std::ranges::iterator_t<View>,
+                                         std::ranges::iterator_t<View>> Pred>
+    requires std::ranges::view<View> && std::is_object_v<Pred> && std::
+        sized_sentinel_for<std::ranges::sentinel_t<View>,
+                           std::ranges::iterator_t<View>>
+class chunk_by_sorted_view
+    : public std::ranges::view_interface<chunk_by_sorted_view<View, Pred>> {
+public:
+    class iterator {
+        friend class chunk_by_sorted_view;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::ranges::subrange<std::ranges::iterator_t<View>>;
+        using difference_type = std::ranges::range_difference_t<View>;
+
+        iterator() = default;
+
+        constexpr value_type operator*() const
+        {
+            return std::ranges::subrange(current_, next_);
+        }
+
+        constexpr iterator& operator++()
+        {
+            IRIS_ASSERT(current_ != next_);
+            current_ = next_;
+            next_ = parent_->find_next(current_);
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+        {
+            return lhs.current_ == rhs.current_;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         std::default_sentinel_t)
+        {
+            return lhs.current_ == lhs.next_;
+        }
+
+    private:
+        constexpr iterator(chunk_by_sorted_view& parent,
+                           std::ranges::iterator_t<View> current,
+                           std::ranges::iterator_t<View> next)
+            : parent_(std::addressof(parent))
+            , current_(current)
+            , next_(next)
+        {
+        }
+
+        chunk_by_sorted_view* parent_ {};
+        std::ranges::iterator_t<View> current_ {};
+        std::ranges::iterator_t<View> next_ {};
+    };
+
+    chunk_by_sorted_view() requires
+        std::default_initializable<View> && std::default_initializable<Pred>
+    = default;
+
+    constexpr explicit chunk_by_sorted_view(View base, Pred pred)
+        : base_(std::move(base))
+        , pred_(std::in_place, std::move(pred))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() && requires std::move_constructible<View>
+    {
+        return std::move(base_);
+    }
+
+    constexpr const Pred& pred() const
+    {
+        return *pred_;
+    }
+
+    constexpr iterator begin()
+    {
+        IRIS_ASSERT(pred_);
+        return iterator { *this, std::ranges::begin(base_),
+                          find_next(std::ranges::begin(base_)) };
+    }
+
+    constexpr auto end()
+    {
+        if constexpr (std::ranges::common_range<View>) {
+            return iterator { *this, std::ranges::end(base_),
+                              std::ranges::end(base_) };
+        } else {
+            return std::default_sentinel;
+        }
+    }
+
+private:
+    constexpr std::ranges::iterator_t<View>
+    find_next(std::ranges::iterator_t<View> current)
+    {
+        IRIS_ASSERT(pred_);
+
+        const auto size = std::ranges::end(base_) - current;
+        if (size == 0) {
+            return current;
+        }
+
+        auto in_chunk = [&](auto&& element) {
+            return std::invoke(*pred_, *current,
+                               std::forward<decltype(element)>(element));
+        };
+
+        // doubles the step until it leaves the chunk, then searches the
+        // last step.
+        std::ranges::range_difference_t<View> first = 1;
+        std::ranges::range_difference_t<View> step = 1;
+        while (step < size && in_chunk(current[step])) {
+            first = step + 1;
+            step *= 2;
+        }
+
+        return std::ranges::partition_point(current + first,
+                                            current + std::min(step, size),
+                                            in_chunk);
+    }
+
+    View base_ {};
+    __detail::__copyable_box<Pred> pred_ {};
+};
+
+template <typename Range, typename Pred>
+chunk_by_sorted_view(Range&&, Pred)
+    -> chunk_by_sorted_view<std::views::all_t<Range>, Pred>;
+
+namespace views {
+    class __chunk_by_sorted_fn {
+    public:
+        template <std::ranges::viewable_range Range, typename Pred>
+        constexpr auto operator()(Range&& range, Pred&& pred) const
+            noexcept(noexcept(chunk_by_sorted_view(
+                std::forward<Range>(range), std::forward<Pred>(pred))))
+                -> decltype(chunk_by_sorted_view(std::forward<Range>(range),
+                                                 std::forward<Pred>(pred)))
+        {
+            return chunk_by_sorted_view(std::forward<Range>(range),
+                                        std::forward<Pred>(pred));
+        }
+
+        template <typename Pred>
+        constexpr auto operator()(Pred&& pred) const //
+            noexcept(std::is_nothrow_constructible_v<std::decay_t<Pred>,
+                                                     Pred>) //
+            requires std::constructible_from<std::decay_t<Pred>, Pred>
+        {
+            return range_adaptor_closure(
+                bind_back(*this, std::forward<Pred>(pred)));
+        }
+    };
+
+    inline constexpr __chunk_by_sorted_fn chunk_by_sorted {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/span_window_view.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+namespace iris::ranges {
+
+// splits a contiguous range into chunks of exactly `N` elements, each of
+// which is a `std::span<T, N>`. the elements after the last full chunk are
+// left out of the iteration, and can be accessed through `remainder()`.
+template <std::ranges::view View, std::size_t N>
+    requires std::ranges::contiguous_range<View> && std::ranges::
+        sized_range<View> &&(N > 0 && N != std::dynamic_extent)
+class chunk_exact_view
+    : public __detail::
+          __span_window_view<chunk_exact_view<View, N>, View, N, N> {
+    using Base = __detail::__span_window_view<chunk_exact_view, View, N, N>;
+
+public:
+    chunk_exact_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit chunk_exact_view(View base)
+        : Base(std::move(base))
+    {
+    }
+
+    // the elements after the last full chunk.
+    constexpr auto remainder() requires(!__detail::__simple_view<View>)
+    {
+        return std::span(std::ranges::data(this->base_) + this->size() * N,
+                         std::ranges::size(this->base_) % N);
+    }
+
+    constexpr auto remainder() const
+        requires std::ranges::contiguous_range<const View>
+    {
+        return std::span(std::ranges::data(this->base_) + this->size() * N,
+                         std::ranges::size(this->base_) % N);
+    }
+};
+
+namespace views {
+    template <std::size_t N>
+    class __chunk_exact_fn
+        : public range_adaptor_closure<__chunk_exact_fn<N>> {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto operator()(Range&& range) const
+            noexcept(noexcept(chunk_exact_view<std::views::all_t<Range&&>, N>(
+                std::forward<Range>(range))))
+                -> decltype(chunk_exact_view<std::views::all_t<Range&&>, N>(
+                    std::forward<Range>(range)))
+        {
+            return chunk_exact_view<std::views::all_t<Range&&>, N>(
+                std::forward<Range>(range));
+        }
+    };
+
+    template <std::size_t N>
+    inline constexpr __chunk_exact_fn<N> chunk_exact {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
+
+namespace std::ranges {
+template <class View, size_t N>
+inline constexpr bool enable_borrowed_range<
+    iris::ranges::chunk_exact_view<View, N>> = enable_borrowed_range<View>;
+}
@@ -9,8 +9,24 @@
 #include <iris/utility.hpp>
 
 #include <algorithm>
+#include <memory>
+#include <span>
 
 namespace iris::ranges {
+namespace __chunk_view_detail {
+    // clang-format off
+    template <typename Range>
+    concept __contiguous_sized = std::ranges::contiguous_range<Range> 
+        && std::sized_sentinel_for<
+            std::ranges::sentinel_t<Range>, 
+            std::ranges::iterator_t<Range>>;
+    // clang-format on
+
+    template <typename Range, std::size_t Extent = std::dynamic_extent>
+    using __span_t = std::span<
+        std::remove_reference_t<std::ranges::range_reference_t<Range>>,
+        Extent>;
+}
 
 template <std::ranges::view View>
     requires std::ranges::input_range<View>
@@ -310,11 +326,16 @@ public:
             std::conditional_t<std::ranges::bidirectional_range<Base>,
                                std::bidirectional_iterator_tag,
                                std::forward_iterator_tag>>;
-        using value_type = decltype(std::views::take(
-            std::ranges::subrange(
-                std::declval<std::ranges::iterator_t<Base>>(),
-                std::declval<std::ranges::sentinel_t<Base>>()),
-            std::declval<std::ranges::range_difference_t<Base>>()));
+        // the chunks of a contiguous range are spans, so that their
+        // contiguity and sizes are visible to the loops over them.
+        using value_type = std::conditional_t<
+            __chunk_view_detail::__contiguous_sized<Base>,
+            __chunk_view_detail::__span_t<Base>,
+            decltype(std::views::take(
+                std::ranges::subrange(
+                    std::declval<std::ranges::iterator_t<Base>>(),
+                    std::declval<std::ranges::sentinel_t<Base>>()),
+                std::declval<std::ranges::range_difference_t<Base>>()))>;
         using difference_type = std::ranges::range_difference_t<Base>;
 
         iterator() = default;
@@ -344,7 +365,14 @@ public:
         constexpr value_type operator*() const
         {
             IRIS_ASSERT(current_ != end_);
-            return std::views::take(std::ranges::subrange(current_, end_), n_);
+            if constexpr (__chunk_view_detail::__contiguous_sized<Base>) {
+                return value_type(std::to_address(current_),
+                                  static_cast<std::size_t>(
+                                      std::ranges::min(n_, end_ - current_)));
+            } else {
+                return std::views::take(std::ranges::subrange(current_, end_),
+                                        n_);
+            }
         }
 
         constexpr iterator& operator++()
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/non_propagating_cache.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+#include <iris/ranges/segments.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <vector>
+
+namespace iris::ranges {
+namespace __concat_ranges_view_detail {
+    // clang-format off
+    template <typename Range>
+    concept __random_access_sized = std::ranges::random_access_range<Range>
+        && std::ranges::sized_range<Range>;
+
+    template <typename Range>
+    concept __random_access_sized_common = __random_access_sized<Range>
+        && std::ranges::common_range<Range>;
+
+    template <typename View>
+    concept __concatenable = __random_access_sized<View>
+        && __random_access_sized_common<std::ranges::range_reference_t<View>>
+        && std::ranges::borrowed_range<std::ranges::range_reference_t<View>>;
+    // clang-format on
+}
+
+// concatenates the ranges of a random access range of ranges into a single
+// random access range. the sizes of the ranges are cached the first time the
+// iteration begins or the size is queried, so that an element can be located
+// by a binary search and the size is known in constant time.
+// like the cached position of `std::ranges::filter_view`, the cache is not
+// updated if the sizes of the ranges change afterwards, and is not copied
+// with the view.
+template <std::ranges::view View>
+    requires __concat_ranges_view_detail::__concatenable<View>
+class concat_ranges_view
+    : public std::ranges::view_interface<concat_ranges_view<View>> {
+    using InnerRange = std::ranges::range_reference_t<View>;
+    using InnerIter = std::ranges::iterator_t<InnerRange>;
+
+public:
+    class iterator {
+        friend class concat_ranges_view;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category =
+            typename std::iterator_traits<InnerIter>::iterator_category;
+        using value_type = std::ranges::range_value_t<InnerRange>;
+        using difference_type
+            = std::common_type_t<std::ranges::range_difference_t<View>,
+                                 std::ranges::range_difference_t<InnerRange>>;
+
+        iterator() = default;
+
+        constexpr decltype(auto) operator*() const
+        {
+            return *inner_it_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++inner_it_;
+            satisfy();
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator--()
+        {
+            while (inner_it_ == std::ranges::begin(__inner(index_))) {
+                --index_;
+                inner_it_ = std::ranges::end(__inner(index_));
+            }
+            --inner_it_;
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator+=(difference_type offset)
+        {
+            if (offset != 0) {
+                seek(position() + offset);
+            }
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type offset)
+        {
+            return *this += -offset;
+        }
+
+        constexpr decltype(auto) operator[](difference_type offset) const
+        {
+            return *(*this + offset);
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_ && lhs.inner_it_ == rhs.inner_it_;
+        }
+
+        friend constexpr std::strong_ordering operator<=>(const iterator& lhs,
+                                                          const iterator& rhs)
+        {
+            if (lhs.index_ != rhs.index_) {
+                return lhs.index_ <=> rhs.index_;
+            }
+            if (lhs.inner_it_ < rhs.inner_it_) {
+                return std::strong_ordering::less;
+            }
+            if (rhs.inner_it_ < lhs.inner_it_) {
+                return std::strong_ordering::greater;
+            }
+            return std::strong_ordering::equal;
+        }
+
+        friend constexpr iterator operator+(const iterator& it,
+                                            difference_type offset)
+        {
+            return iterator { it } += offset;
+        }
+
+        friend constexpr iterator operator+(difference_type offset,
+                                            const iterator& it)
+        {
+            return it + offset;
+        }
+
+        friend constexpr iterator operator-(const iterator& it,
+                                            difference_type offset)
+        {
+            return iterator { it } -= offset;
+        }
+
+        friend constexpr difference_type operator-(const iterator& lhs,
+                                                   const iterator& rhs)
+        {
+            if (lhs.index_ == rhs.index_) {
+                return static_cast<difference_type>(lhs.inner_it_
+                                                    - rhs.inner_it_);
+            }
+            return lhs.position() - rhs.position();
+        }
+
+        friend constexpr decltype(auto) iter_move(const iterator& it) noexcept(
+            noexcept(std::ranges::iter_move(it.inner_it_)))
+        {
+            return std::ranges::iter_move(it.inner_it_);
+        }
+
+        friend constexpr void
+        iter_swap(const iterator& lhs, const iterator& rhs) noexcept(
+            noexcept(std::ranges::iter_swap(lhs.inner_it_, rhs.inner_it_)))
+            requires std::indirectly_swappable<InnerIter>
+        {
+            std::ranges::iter_swap(lhs.inner_it_, rhs.inner_it_);
+        }
+
+    private:
+        constexpr iterator(concat_ranges_view& parent,
+                           std::size_t index,
+                           InnerIter inner_it)
+            : parent_(std::addressof(parent))
+            , index_(index)
+            , inner_it_(std::move(inner_it))
+        {
+        }
+
+        constexpr decltype(auto) __inner(std::size_t index) const
+        {
+            return std::ranges::begin(parent_->base_)[static_cast<
+                std::ranges::range_difference_t<View>>(index)];
+        }
+
+        // skips the ends of all but the last range.
+        constexpr void satisfy()
+        {
+            const auto last = (*parent_->prefix_sizes_).size() - 2;
+            while (index_ < last
+                   && inner_it_ == std::ranges::end(__inner(index_))) {
+                ++index_;
+                inner_it_ = std::ranges::begin(__inner(index_));
+            }
+        }
+
+        // the offset of the iterator from the beginning of the view.
+        constexpr difference_type position() const
+        {
+            return (*parent_->prefix_sizes_)[index_]
+                + static_cast<difference_type>(
+                       inner_it_ - std::ranges::begin(__inner(index_)));
+        }
+
+        // moves the iterator to `position`, into the last range which starts
+        // at or before it.
+        constexpr void seek(difference_type position)
+        {
+            const auto& prefix_sizes = *parent_->prefix_sizes_;
+            IRIS_ASSERT(position >= 0 && position <= prefix_sizes.back());
+            index_ = static_cast<std::size_t>(
+                std::upper_bound(prefix_sizes.begin(),
+                                 std::prev(prefix_sizes.end()), position)
+                - prefix_sizes.begin() - 1);
+            inner_it_ = std::ranges::begin(__inner(index_))
+                + (position - prefix_sizes[index_]);
+        }
+
+        concat_ranges_view* parent_ = nullptr;
+        std::size_t index_ = 0;
+        InnerIter inner_it_ {};
+    };
+
+    concat_ranges_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit concat_ranges_view(View base)
+        : base_(std::move(base))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr iterator begin()
+    {
+        __cache_prefix_sizes();
+        if (std::ranges::empty(base_)) {
+            return iterator {};
+        }
+
+        iterator it(*this, 0, std::ranges::begin(*std::ranges::begin(base_)));
+        it.satisfy();
+        return it;
+    }
+
+    constexpr iterator end()
+    {
+        __cache_prefix_sizes();
+        if (std::ranges::empty(base_)) {
+            return iterator {};
+        }
+
+        const auto last = std::ranges::size(base_) - 1;
+        auto&& inner = std::ranges::begin(base_)[static_cast<
+            std::ranges::range_difference_t<View>>(last)];
+        return iterator(*this, last, std::ranges::end(inner));
+    }
+
+    constexpr auto size()
+    {
+        __cache_prefix_sizes();
+        return static_cast<std::make_unsigned_t<difference_type>>(
+            (*prefix_sizes_).back());
+    }
+
+    constexpr auto size() const requires
+        __concat_ranges_view_detail::__concatenable<const View>
+    {
+        return __size(base_);
+    }
+
+    // visits the segments of the ranges in order, see `ranges::segments`.
+    template <typename F>
+    constexpr bool segments(F&& f)
+    {
+        __cache_prefix_sizes();
+        std::size_t index = 0;
+        for (auto&& inner : base_) {
+            bool completed = ranges::segments(
+                inner, [&](auto& segment, auto position) {
+                    return std::invoke(
+                        f, segment, [this, index, position](auto it) {
+                            return iterator(*this, index,
+                                            position(std::move(it)));
+                        });
+                });
+            if (!completed) {
+                return false;
+            }
+            ++index;
+        }
+        return true;
+    }
+
+#if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
+    void __placeholder();
+#endif
+
+private:
+    using difference_type = typename iterator::difference_type;
+
+    template <typename Base>
+    static constexpr auto __size(Base& base)
+    {
+        using size_type = std::make_unsigned_t<difference_type>;
+        size_type size = 0;
+        for (auto&& inner : base) {
+            size += static_cast<size_type>(std::ranges::size(inner));
+        }
+        return size;
+    }
+
+    constexpr void __cache_prefix_sizes()
+    {
+        if (prefix_sizes_.has_value()) {
+            return;
+        }
+
+        auto& prefix_sizes = prefix_sizes_.emplace();
+        prefix_sizes.reserve(std::ranges::size(base_) + 1);
+        prefix_sizes.push_back(0);
+        for (auto&& inner : base_) {
+            prefix_sizes.push_back(
+                prefix_sizes.back()
+                + static_cast<difference_type>(std::ranges::size(inner)));
+        }
+    }
+
+    View base_ {};
+    __detail::__non_propagating_cache<std::vector<difference_type>>
+        prefix_sizes_;
+};
+
+template <typename Range>
+concat_ranges_view(Range&&) -> concat_ranges_view<std::views::all_t<Range>>;
+
+namespace views {
+    class __concat_ranges_fn
+        : public range_adaptor_closure<__concat_ranges_fn> {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto operator()(Range&& range) const
+            noexcept(noexcept(concat_ranges_view(std::forward<Range>(range))))
+                -> decltype(concat_ranges_view(std::forward<Range>(range)))
+        {
+            return concat_ranges_view(std::forward<Range>(range));
+        }
+    };
+
+    inline constexpr __concat_ranges_fn concat_ranges {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
@@ -3,10 +3,11 @@
 #include <iris/config.hpp>
 
 #include <iris/ranges/__detail/utility.hpp>
+#include <iris/ranges/segments.hpp>
 #include <iris/type_traits.hpp>
 
+#include <algorithm>
 #include <array>
-#include <numeric>
 #include <variant>
 
 namespace iris::ranges {
@@ -86,6 +87,24 @@ namespace __concat_view_detail {
                                std::forward<Variant>(v));
         }
     }
+
+    template <std::size_t N, typename F>
+    constexpr auto __visit_index(std::size_t index, F&& f)
+    {
+        if (index == N) {
+            return std::invoke(std::forward<F>(f),
+                               std::integral_constant<std::size_t, N> {});
+        }
+        if constexpr (N > 0) {
+            return __visit_index<N - 1>(index, std::forward<F>(f));
+        } else {
+            return std::invoke(std::forward<F>(f),
+                               std::integral_constant<std::size_t, N> {});
+        }
+    }
+
+    struct __empty {
+    };
 }
 
 template <std::ranges::input_range... Views>
@@ -238,24 +257,9 @@ public:
                 __detail::__maybe_const<Const, Views>...>
         {
             IRIS_ASSERT(!it_.valueless_by_exception());
-            if (offset > 0) {
-                __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
-                    [&](auto I, auto& it) {
-                        advance_fwd<I>(std::get<I>(it)
-                                           - std::ranges::begin(
-                                               std::get<I>(__parent_bases())),
-                                       offset);
-                    },
-                    it_);
-            } else if (offset < 0) {
-                __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
-                    [&](auto I, auto& it) {
-                        advance_bwd<I>(std::get<I>(it)
-                                           - std::ranges::begin(
-                                               std::get<I>(__parent_bases())),
-                                       -offset);
-                    },
-                    it_);
+            if (offset != 0) {
+                const auto& prefix_sizes = __prefix_sizes();
+                __seek(prefix_sizes, __position(prefix_sizes) + offset);
             }
             return *this;
         }
@@ -382,44 +386,16 @@ public:
         {
             IRIS_ASSERT(!lhs.it_.valueless_by_exception());
             IRIS_ASSERT(!rhs.it_.valueless_by_exception());
-            const auto il = lhs.it_.index();
-            const auto ir = rhs.it_.index();
-            if (il > ir) {
-                auto dr
-                    = __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
-                        [&](auto I, auto& it) {
-                            return std::ranges::end(
-                                       std::get<I>(rhs.__parent_bases()))
-                                - std::get<I>(it);
-                        },
-                        rhs.it_);
-                auto dl
-                    = __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
-                        [&](auto I, auto& it) {
-                            return std::get<I>(it)
-                                - std::ranges::begin(
-                                       std::get<I>(lhs.__parent_bases()));
-                        },
-                        lhs.it_);
-                auto sizes = std::apply(
-                    [](auto&... bases) {
-                        return std::array { static_cast<difference_type>(
-                            std::ranges::size(bases))... };
-                    },
-                    lhs.__parent_bases());
-                auto s
-                    = std::accumulate(sizes.data() + ir + 1, sizes.data() + il,
-                                      difference_type(0), std::plus());
-                return dr + s + dl;
-            } else if (il < ir) {
-                return -(rhs - lhs);
-            } else {
+            if (lhs.it_.index() == rhs.it_.index()) {
                 return __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
-                    [&](auto I, auto& it) {
+                    [&](auto I, auto& it) -> difference_type {
                         return std::get<I>(it) - std::get<I>(rhs.it_);
                     },
                     lhs.it_);
             }
+
+            const auto& prefix_sizes = lhs.__prefix_sizes();
+            return lhs.__position(prefix_sizes) - rhs.__position(prefix_sizes);
         }
 
         friend constexpr difference_type operator-(const iterator& lhs,
@@ -428,7 +404,8 @@ public:
                 __detail::__maybe_const<Const, Views>...>
         {
             IRIS_ASSERT(!lhs.it_.valueless_by_exception());
-            // TODO:
+            const auto& prefix_sizes = lhs.__prefix_sizes();
+            return lhs.__position(prefix_sizes) - prefix_sizes.back();
         }
 
         friend constexpr difference_type operator-(std::default_sentinel_t lhs,
@@ -530,43 +507,62 @@ public:
             }
         }
 
-        template <std::size_t N>
-        constexpr void advance_fwd(difference_type offset,
-                                   difference_type steps)
+        // the number of elements before each base, followed by the number of
+        // elements in total.
+        constexpr decltype(auto) __prefix_sizes() const
         {
-            if constexpr (N == pack_size_v<Views...> - 1) {
-                std::get<N>(it_) += steps;
+            if constexpr (__concat_view_detail::__concat_random_access<
+                              Views...>) {
+                return (parent_->prefix_sizes_);
             } else {
-                auto n_size = std::ranges::size(std::get<N>(__parent_bases()));
-                if (offset + steps < static_cast<difference_type>(n_size)) {
-                    std::get<N>(it_) += steps;
-                } else {
-                    it_.template emplace<N + 1>(
-                        std::ranges::begin(get<N + 1>(__parent_bases())));
-                    advance_fwd<N + 1>(0, offset + steps - n_size);
-                }
+                return std::apply(
+                    [](auto&... bases) {
+                        std::array<difference_type, pack_size_v<Views...> + 1>
+                            prefix_sizes {};
+                        std::size_t i = 0;
+                        ((prefix_sizes[i + 1] = prefix_sizes[i]
+                              + static_cast<difference_type>(
+                                  std::ranges::size(bases)),
+                          ++i),
+                         ...);
+                        return prefix_sizes;
+                    },
+                    __parent_bases());
             }
         }
 
-        template <std::size_t N>
-        constexpr void advance_bwd(difference_type offset,
-                                   difference_type steps)
+        // the offset of the iterator from the beginning of the view.
+        template <typename PrefixSizes>
+        constexpr difference_type
+        __position(const PrefixSizes& prefix_sizes) const
         {
-            if constexpr (N == 0) {
-                std::get<N>(it_) -= steps;
-            } else {
-                if (offset >= steps) {
-                    std::get<N>(it_) -= steps;
-                } else {
-                    it_.template emplace<N - 1>(
-                        std::ranges::begin(get<N - 1>(__parent_bases()))
-                        + std::ranges::size(get<N - 1>(__parent_bases())));
-                    advance_bwd<N - 1>(
-                        static_cast<difference_type>(
-                            std::ranges::size(get<N - 1>(__parent_bases()))),
-                        steps - offset);
-                }
-            }
+            return __concat_view_detail::__visit<pack_size_v<Views...> - 1>(
+                [&](auto I, auto& it) -> difference_type {
+                    return prefix_sizes[I] + static_cast<difference_type>(
+                        std::get<I>(it)
+                        - std::ranges::begin(std::get<I>(__parent_bases())));
+                },
+                it_);
+        }
+
+        // moves the iterator to `position`, into the last base which starts
+        // at or before it, so that it never rests at the end of a base other
+        // than the last one.
+        template <typename PrefixSizes>
+        constexpr void __seek(const PrefixSizes& prefix_sizes,
+                              difference_type position)
+        {
+            IRIS_ASSERT(position >= 0 && position <= prefix_sizes.back());
+            auto index = static_cast<std::size_t>(
+                std::upper_bound(prefix_sizes.begin(),
+                                 std::prev(prefix_sizes.end()), position)
+                - prefix_sizes.begin() - 1);
+            __concat_view_detail::__visit_index<pack_size_v<Views...> - 1>(
+                index, [&](auto I) {
+                    it_.template emplace<I>(
+                        std::ranges::begin(std::get<I>(__parent_bases()))
+                        + (position - prefix_sizes[I]));
+                });
         }
 
         constexpr auto& __parent_bases() const
@@ -578,16 +574,21 @@ public:
         BaseIterator it_ {};
     };
 
+    // if all the bases are random access and sized, their sizes are stored
+    // when the view is constructed, for the random access of the iterators.
+    // the bases must not change their sizes afterwards.
     constexpr concat_view() requires(std::default_initializable<Views>&&...)
-        = default;
+    {
+        __store_prefix_sizes();
+    }
 
     constexpr explicit concat_view(Views... bases)
         : bases_(std::move(bases)...)
     {
+        __store_prefix_sizes();
     }
 
-    constexpr auto begin() //
-        requires(!(__detail::__simple_view<Views> && ...))
+    constexpr auto begin() requires(!(__detail::__simple_view<Views> && ...))
     {
         iterator<false> it(*this, std::in_place_index<0>,
                            std::ranges::begin(std::get<0>(bases_)));
@@ -622,7 +623,7 @@ public:
         if constexpr (std::ranges::common_range<
                           back_of_pack_element_t<const Views...>>) {
             constexpr auto N = pack_size_v<Views...>;
-            return iterator<true>(this, std::in_place_index<N - 1>,
+            return iterator<true>(*this, std::in_place_index<N - 1>,
                                   std::ranges::end(get<N - 1>(bases_)));
         } else {
             return std::default_sentinel;
@@ -645,12 +646,80 @@ public:
     {
     }
 
+    // visits the segments of the base ranges in order, see
+    // `ranges::segments`.
+    template <typename F>
+    constexpr bool segments(F&& f) //
+        requires(!(__detail::__simple_view<Views> && ...))
+    {
+        return __segments<false>(*this, f);
+    }
+
+    template <typename F>
+    constexpr bool segments(F&& f) const
+        requires((std::ranges::range<const Views> && ...)
+                 && __concat_view_detail::__concatable<const Views...>)
+    {
+        return __segments<true>(*this, f);
+    }
+
 #if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
     void __placeholder();
 #endif
 
 private:
+    constexpr void __store_prefix_sizes()
+    {
+        if constexpr (__concat_view_detail::__concat_random_access<Views...>) {
+            std::apply(
+                [&](auto&... bases) {
+                    using difference_type
+                        = std::ranges::range_value_t<__prefix_sizes_type>;
+                    std::size_t i = 0;
+                    ((prefix_sizes_[i + 1] = prefix_sizes_[i]
+                          + static_cast<difference_type>(
+                              std::ranges::size(bases)),
+                      ++i),
+                     ...);
+                },
+                bases_);
+        }
+    }
+
+    template <bool Const, typename F>
+    static constexpr bool
+    __segments(__detail::__maybe_const<Const, concat_view>& self, F& f)
+    {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            return (__segments_of<Const, Is>(self, f) && ...);
+        }
+        (std::index_sequence_for<Views...> {});
+    }
+
+    template <bool Const, std::size_t I, typename F>
+    static constexpr bool
+    __segments_of(__detail::__maybe_const<Const, concat_view>& self, F& f)
+    {
+        return ranges::segments(
+            std::get<I>(self.bases_), [&](auto& segment, auto position) {
+                return std::invoke(
+                    f, segment, [&self, position](auto it) {
+                        return iterator<Const>(self, std::in_place_index<I>,
+                                               position(std::move(it)));
+                    });
+            });
+    }
+
+    using __prefix_sizes_type = std::conditional_t<
+        __concat_view_detail::__concat_random_access<Views...>,
+        std::array<
+            std::common_type_t<std::ranges::range_difference_t<Views>...>,
+            pack_size_v<Views...> + 1>,
+        __concat_view_detail::__empty>;
+
     std::tuple<Views...> bases_ {};
+    [[no_unique_address]] __prefix_sizes_type prefix_sizes_ {};
 };
 
 template <typename... Ranges>
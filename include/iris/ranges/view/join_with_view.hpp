@@ -6,6 +6,7 @@
 #include <iris/ranges/__detail/non_propagating_cache.hpp>
 #include <iris/ranges/__detail/utility.hpp>
 #include <iris/ranges/range_adaptor_closure.hpp>
+#include <iris/ranges/segments.hpp>
 
 #include <variant>
 
@@ -305,6 +306,17 @@ public:
             }
         }
 
+        template <std::size_t I, typename It>
+        constexpr iterator(Parent& parent,
+                           OuterIter outer_it,
+                           std::in_place_index_t<I>,
+                           It it)
+            : parent_(std::addressof(parent))
+            , outer_it_(std::move(outer_it))
+            , inner_it_(std::in_place_index<I>, std::move(it))
+        {
+        }
+
         constexpr auto&& update_inner(const OuterIter& outer)
         {
             if constexpr (ref_is_glvalue) {
@@ -487,11 +499,66 @@ public:
         }
     }
 
+    // visits the inner ranges and the patterns between them in order, see
+    // `ranges::segments`.
+    template <typename F>
+    constexpr bool segments(F&& f)
+        // clang-format off
+        requires std::ranges::forward_range<View> 
+            && std::is_reference_v<InnerRange>
+    // clang-format on
+    {
+        constexpr bool is_const = __detail::__simple_view<View>
+            && __detail::__simple_view<Pattern>;
+        return __segments<is_const>(*this, f);
+    }
+
+    template <typename F>
+    constexpr bool segments(F&& f) const
+        // clang-format off
+        requires std::ranges::forward_range<const View> 
+            && std::ranges::forward_range<const Pattern> 
+            && std::is_reference_v<std::ranges::range_reference_t<const View>>
+    // clang-format on
+    {
+        return __segments<true>(*this, f);
+    }
+
 #if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
     void __placeholder();
 #endif
 
 private:
+    template <bool Const, typename F>
+    static constexpr bool
+    __segments(__detail::__maybe_const<Const, join_with_view>& self, F& f)
+    {
+        auto visit = [&]<std::size_t I>(std::in_place_index_t<I>, auto&& range,
+                                        const auto& outer) {
+            return ranges::segments(range, [&](auto& segment, auto position) {
+                return std::invoke(
+                    f, segment, [&self, outer, position](auto it) {
+                        return iterator<Const>(self, outer,
+                                               std::in_place_index<I>,
+                                               position(std::move(it)));
+                    });
+            });
+        };
+
+        auto outer = std::ranges::begin(self.base_);
+        const auto last = std::ranges::end(self.base_);
+        for (bool first = true; outer != last; ++outer, first = false) {
+            if (!first
+                && !visit(std::in_place_index<0>, self.pattern_, outer)) {
+                return false;
+            }
+            if (!visit(std::in_place_index<1>, *outer, outer)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     View base_ {};
     Pattern pattern_ {};
 };
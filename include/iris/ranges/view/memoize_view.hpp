@@ -0,0 +1,218 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/ranges/__detail/non_propagating_cache.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+#include <compare>
+#include <optional>
+#include <vector>
+
+namespace iris::ranges {
+
+// stores each element of a random access range the first time it is
+// accessed, so that it is computed once however many times and in whichever
+// order it is accessed afterwards. the buffer is allocated when the iteration
+// begins, and is not copied with the view.
+template <std::ranges::view View>
+    requires std::ranges::random_access_range<View> && std::ranges::
+        sized_range<View> && std::move_constructible<
+            std::remove_cvref_t<std::ranges::range_reference_t<View>>>
+class memoize_view : public std::ranges::view_interface<memoize_view<View>> {
+    using element_type
+        = std::remove_cvref_t<std::ranges::range_reference_t<View>>;
+
+public:
+    class iterator {
+        friend class memoize_view;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = element_type;
+        using difference_type = std::ranges::range_difference_t<View>;
+
+        iterator() = default;
+
+        constexpr const element_type& operator*() const
+        {
+            return parent_->__at(index_);
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator--()
+        {
+            --index_;
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator+=(difference_type offset)
+        {
+            index_ += offset;
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type offset)
+        {
+            index_ -= offset;
+            return *this;
+        }
+
+        constexpr const element_type& operator[](difference_type offset) const
+        {
+            return parent_->__at(index_ + offset);
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend constexpr auto operator<=>(const iterator& lhs,
+                                          const iterator& rhs)
+        {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+        friend constexpr iterator operator+(const iterator& it,
+                                            difference_type offset)
+        {
+            return iterator { it } += offset;
+        }
+
+        friend constexpr iterator operator+(difference_type offset,
+                                            const iterator& it)
+        {
+            return it + offset;
+        }
+
+        friend constexpr iterator operator-(const iterator& it,
+                                            difference_type offset)
+        {
+            return iterator { it } -= offset;
+        }
+
+        friend constexpr difference_type operator-(const iterator& lhs,
+                                                   const iterator& rhs)
+        {
+            return lhs.index_ - rhs.index_;
+        }
+
+    private:
+        constexpr iterator(memoize_view& parent, difference_type index)
+            : parent_(std::addressof(parent))
+            , index_(index)
+        {
+        }
+
+        memoize_view* parent_ = nullptr;
+        difference_type index_ = 0;
+    };
+
+    memoize_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr explicit memoize_view(View base)
+        : base_(std::move(base))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr iterator begin()
+    {
+        __allocate();
+        return iterator(*this, 0);
+    }
+
+    constexpr iterator end()
+    {
+        __allocate();
+        return iterator(*this, static_cast<difference_type>(size()));
+    }
+
+    constexpr auto size()
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<const View>
+    {
+        return std::ranges::size(base_);
+    }
+
+private:
+    using difference_type = typename iterator::difference_type;
+
+    constexpr void __allocate()
+    {
+        if (!buffer_.has_value()) {
+            buffer_.emplace(std::ranges::size(base_));
+        }
+    }
+
+    constexpr const element_type& __at(difference_type index)
+    {
+        auto& element = (*buffer_)[static_cast<std::size_t>(index)];
+        if (!element) {
+            element.emplace(std::ranges::begin(base_)[index]);
+        }
+        return *element;
+    }
+
+    View base_ {};
+    __detail::__non_propagating_cache<std::vector<std::optional<element_type>>>
+        buffer_;
+};
+
+template <typename Range>
+memoize_view(Range&&) -> memoize_view<std::views::all_t<Range>>;
+
+namespace views {
+    class __memoize_fn : public range_adaptor_closure<__memoize_fn> {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto operator()(Range&& range) const
+            noexcept(noexcept(memoize_view(std::forward<Range>(range))))
+                -> decltype(memoize_view(std::forward<Range>(range)))
+        {
+            return memoize_view(std::forward<Range>(range));
+        }
+    };
+
+    inline constexpr __memoize_fn memoize {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
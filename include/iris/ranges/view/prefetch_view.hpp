@@ -0,0 +1,475 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/bind.hpp>
+#include <iris/ranges/__detail/copyable_box.hpp>
+#include <iris/ranges/__detail/utility.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+#include <functional>
+
+#if defined(_MSC_VER) && !defined(__clang__)                                 \
+    && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace iris::ranges {
+namespace __prefetch_view_detail {
+    // clang-format off
+    template <typename T>
+    concept __address = std::is_pointer_v<T> || std::is_lvalue_reference_v<T>;
+
+    template <typename Proj, typename Iter>
+    concept __prefetchable = std::indirectly_regular_unary_invocable<Proj, Iter>
+        && __address<std::indirect_result_t<Proj&, Iter>>;
+    // clang-format on
+
+    constexpr void __prefetch(const void* address) noexcept
+    {
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+        // gcc considers the prefetch free of side effects, and would remove
+        // the calls of `prefetch_ahead` which it does not inline as calls of
+        // a pure function whose result is unused.
+        __asm__ volatile("");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        IRIS_UNUSED(address);
+#endif
+    }
+
+    template <typename T>
+    constexpr void __prefetch_result(T&& result) noexcept
+    {
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<T>>) {
+            __prefetch(result);
+        } else {
+            __prefetch(std::addressof(result));
+        }
+    }
+}
+
+// passes through the elements of a forward range, while issuing a software
+// prefetch for the element `distance` positions ahead of the iterator, or for
+// the address which `proj` returns for it. this hides the cache misses of
+// gathers like `indices | views::transform([&](auto i) -> auto& { return
+// table[i]; })`, which the hardware prefetcher cannot predict.
+template <std::ranges::forward_range View, typename Proj = std::identity>
+    requires std::ranges::view<View> && std::is_object_v<Proj> && //
+    __prefetch_view_detail::__prefetchable<Proj, std::ranges::iterator_t<View>>
+class prefetch_view
+    : public std::ranges::view_interface<prefetch_view<View, Proj>> {
+public:
+    template <bool Const>
+    class iterator {
+        friend class prefetch_view;
+
+        using Parent = __detail::__maybe_const<Const, prefetch_view>;
+        using Base = __detail::__maybe_const<Const, View>;
+
+    public:
+        // clang-format off
+        using iterator_concept =
+            std::conditional_t<
+                std::ranges::random_access_range<Base>,
+                std::random_access_iterator_tag,
+            std::conditional_t<
+                std::ranges::bidirectional_range<Base>,
+                std::bidirectional_iterator_tag,
+                std::forward_iterator_tag>>;
+        using iterator_category = std::conditional_t<
+            std::derived_from<
+                typename std::iterator_traits<
+                    std::ranges::iterator_t<Base>>::iterator_category,
+                std::random_access_iterator_tag>,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<
+                std::ranges::iterator_t<Base>>::iterator_category>;
+        // clang-format on
+        using value_type = std::ranges::range_value_t<Base>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+
+        constexpr iterator(iterator<!Const> other) requires(
+            Const&& std::convertible_to<std::ranges::iterator_t<View>,
+                                        std::ranges::iterator_t<Base>>&&
+                std::convertible_to<std::ranges::sentinel_t<View>,
+                                    std::ranges::sentinel_t<Base>>)
+            : parent_(other.parent_)
+            , current_(std::move(other.current_))
+            , ahead_(std::move(other.ahead_))
+            , end_(std::move(other.end_))
+            , lead_(other.lead_)
+        {
+        }
+
+        constexpr const std::ranges::iterator_t<Base>& base() const& noexcept
+        {
+            return current_;
+        }
+
+        constexpr std::ranges::iterator_t<Base> base() &&
+        {
+            return std::move(current_);
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return *current_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            IRIS_ASSERT(current_ != end_);
+            ++current_;
+            if (ahead_ != end_) {
+                ++ahead_;
+                prefetch_ahead();
+            } else {
+                --lead_;
+            }
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator--() //
+            requires std::ranges::bidirectional_range<Base>
+        {
+            --current_;
+            if (lead_ < parent_->distance_) {
+                ++lead_;
+            } else {
+                --ahead_;
+            }
+            return *this;
+        }
+
+        constexpr iterator operator--(int) //
+            requires std::ranges::bidirectional_range<Base>
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator+=(difference_type offset) //
+            requires std::ranges::random_access_range<Base>
+        {
+            current_ += offset;
+            seek();
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type offset) //
+            requires std::ranges::random_access_range<Base>
+        {
+            return *this += -offset;
+        }
+
+        constexpr decltype(auto) operator[](difference_type offset) const //
+            requires std::ranges::random_access_range<Base>
+        {
+            return current_[offset];
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         std::default_sentinel_t)
+        {
+            return lhs.current_ == lhs.end_;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+        {
+            return lhs.current_ == rhs.current_;
+        }
+
+        friend constexpr auto operator<=>(const iterator& lhs,
+                                          const iterator& rhs) //
+            requires std::ranges::random_access_range<Base> && std::
+                three_way_comparable<std::ranges::iterator_t<Base>>
+        {
+            return lhs.current_ <=> rhs.current_;
+        }
+
+        friend constexpr iterator operator+(const iterator& i,
+                                            difference_type offset) //
+            requires std::ranges::random_access_range<Base>
+        {
+            auto r = i;
+            r += offset;
+            return r;
+        }
+
+        friend constexpr iterator operator+(difference_type offset,
+                                            const iterator& i) //
+            requires std::ranges::random_access_range<Base>
+        {
+            return i + offset;
+        }
+
+        friend constexpr iterator operator-(const iterator& i,
+                                            difference_type offset) //
+            requires std::ranges::random_access_range<Base>
+        {
+            auto r = i;
+            r -= offset;
+            return r;
+        }
+
+        friend constexpr difference_type operator-(const iterator& lhs,
+                                                   const iterator& rhs) //
+            requires std::sized_sentinel_for<std::ranges::iterator_t<Base>,
+                                             std::ranges::iterator_t<Base>>
+        {
+            return lhs.current_ - rhs.current_;
+        }
+
+        friend constexpr difference_type operator-(std::default_sentinel_t,
+                                                   const iterator& rhs) //
+            requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>,
+                                             std::ranges::iterator_t<Base>>
+        {
+            return rhs.end_ - rhs.current_;
+        }
+
+        friend constexpr difference_type
+        operator-(const iterator& lhs,
+                  std::default_sentinel_t rhs) //
+            requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>,
+                                             std::ranges::iterator_t<Base>>
+        {
+            return -(rhs - lhs);
+        }
+
+        friend constexpr std::ranges::range_rvalue_reference_t<Base>
+        iter_move(const iterator& i) noexcept(
+            noexcept(std::ranges::iter_move(i.current_)))
+        {
+            return std::ranges::iter_move(i.current_);
+        }
+
+        friend constexpr void
+        iter_swap(const iterator& lhs, const iterator& rhs) noexcept(
+            noexcept(std::ranges::iter_swap(lhs.current_, rhs.current_))) //
+            requires std::indirectly_swappable<std::ranges::iterator_t<Base>>
+        {
+            return std::ranges::iter_swap(lhs.current_, rhs.current_);
+        }
+
+#if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
+        void __placeholder();
+#endif
+
+    private:
+        constexpr iterator(Parent* parent,
+                           std::ranges::iterator_t<Base> current)
+            : parent_(parent)
+            , current_(std::move(current))
+            , end_(std::ranges::end(parent->base_))
+        {
+            // warms up the elements up to `distance` positions ahead.
+            ahead_ = current_;
+            while (lead_ < parent_->distance_ && ahead_ != end_) {
+                ++ahead_;
+                ++lead_;
+                prefetch_ahead();
+            }
+        }
+
+        constexpr void prefetch_ahead()
+        {
+            if (ahead_ != end_) {
+                __prefetch_view_detail::__prefetch_result(
+                    std::invoke(*parent_->proj_, *ahead_));
+            }
+        }
+
+        // moves `ahead_` to `distance` positions ahead of `current_`, or to
+        // the end.
+        constexpr void seek()
+        {
+            ahead_ = current_;
+            lead_ = parent_->distance_
+                - std::ranges::advance(ahead_, parent_->distance_, end_);
+            prefetch_ahead();
+        }
+
+        Parent* parent_ = nullptr;
+        std::ranges::iterator_t<Base> current_ {};
+        std::ranges::iterator_t<Base> ahead_ {};
+        std::ranges::sentinel_t<Base> end_ {};
+        // the distance from `current_` to `ahead_`, which is less than
+        // `distance` only near the end.
+        difference_type lead_ = 0;
+    };
+
+    prefetch_view() requires
+        std::default_initializable<View> && std::default_initializable<Proj>
+    = default;
+
+    constexpr prefetch_view(View base,
+                            Proj proj,
+                            std::ranges::range_difference_t<View> distance)
+        : base_(std::move(base))
+        , proj_(std::in_place, std::move(proj))
+        , distance_(distance)
+    {
+        IRIS_ASSERT(distance_ >= 0);
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr std::ranges::range_difference_t<View> distance() const noexcept
+    {
+        return distance_;
+    }
+
+    constexpr auto begin() requires(!__detail::__simple_view<View>)
+    {
+        return iterator<false>(this, std::ranges::begin(base_));
+    }
+
+    // clang-format off
+    constexpr auto begin() const
+        requires std::ranges::forward_range<const View>
+            && __prefetch_view_detail::__prefetchable<
+                const Proj, std::ranges::iterator_t<const View>>
+    // clang-format on
+    {
+        return iterator<true>(this, std::ranges::begin(base_));
+    }
+
+    constexpr auto end() requires(!__detail::__simple_view<View>)
+    {
+        if constexpr (std::ranges::common_range<View>) {
+            return iterator<false>(this, std::ranges::end(base_));
+        } else {
+            return std::default_sentinel;
+        }
+    }
+
+    // clang-format off
+    constexpr auto end() const
+        requires std::ranges::forward_range<const View>
+            && __prefetch_view_detail::__prefetchable<
+                const Proj, std::ranges::iterator_t<const View>>
+    // clang-format on
+    {
+        if constexpr (std::ranges::common_range<const View>) {
+            return iterator<true>(this, std::ranges::end(base_));
+        } else {
+            return std::default_sentinel;
+        }
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<View>
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<const View>
+    {
+        return std::ranges::size(base_);
+    }
+
+#if IRIS_FIX_CLANG_FORMAT_PLACEHOLDER
+    void __placeholder();
+#endif
+
+private:
+    View base_ {};
+    __detail::__copyable_box<Proj> proj_ {};
+    std::ranges::range_difference_t<View> distance_ = 0;
+};
+
+template <typename Range, typename Proj>
+prefetch_view(Range&&, Proj, std::ranges::range_difference_t<Range>)
+    -> prefetch_view<std::views::all_t<Range>, Proj>;
+
+namespace views {
+    class __prefetch_by_fn {
+    public:
+        template <std::ranges::viewable_range Range, typename Proj>
+        constexpr auto
+        operator()(Range&& range,
+                   Proj&& proj,
+                   std::ranges::range_difference_t<Range> distance) const
+            noexcept(noexcept(prefetch_view(std::forward<Range>(range),
+                                            std::forward<Proj>(proj),
+                                            distance)))
+                -> decltype(prefetch_view(std::forward<Range>(range),
+                                          std::forward<Proj>(proj),
+                                          distance))
+        {
+            return prefetch_view(std::forward<Range>(range),
+                                 std::forward<Proj>(proj), distance);
+        }
+
+        template <typename Proj, typename Distance>
+        constexpr auto operator()(Proj&& proj, Distance&& distance) const //
+            noexcept(std::is_nothrow_constructible_v<std::decay_t<Proj>,
+                                                     Proj>) //
+            requires std::constructible_from<std::decay_t<Proj>, Proj>
+        {
+            return range_adaptor_closure(
+                bind_back(*this, std::forward<Proj>(proj),
+                          std::forward<Distance>(distance)));
+        }
+    };
+
+    inline constexpr __prefetch_by_fn prefetch_by {};
+
+    class __prefetch_fn {
+    public:
+        template <std::ranges::viewable_range Range>
+        constexpr auto
+        operator()(Range&& range,
+                   std::ranges::range_difference_t<Range> distance) const
+            noexcept(noexcept(prefetch_by(std::forward<Range>(range),
+                                          std::identity {},
+                                          distance)))
+                -> decltype(prefetch_by(std::forward<Range>(range),
+                                        std::identity {},
+                                        distance))
+        {
+            return prefetch_by(std::forward<Range>(range), std::identity {},
+                               distance);
+        }
+
+        template <typename Distance>
+        constexpr auto operator()(Distance&& distance) const
+        {
+            return range_adaptor_closure(
+                bind_back(*this, std::forward<Distance>(distance)));
+        }
+    };
+
+    inline constexpr __prefetch_fn prefetch {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
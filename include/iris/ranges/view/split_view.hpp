@@ -0,0 +1,253 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/__detail/char_search.hpp>
+#include <iris/bind.hpp>
+#include <iris/ranges/range_adaptor_closure.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace iris::ranges {
+namespace __split_view_detail {
+    // clang-format off
+    template <typename Range>
+    concept __char_range = std::ranges::contiguous_range<Range>
+        && std::ranges::sized_range<Range>
+        && (std::same_as<std::ranges::range_value_t<Range>, char>
+            || std::same_as<std::ranges::range_value_t<Range>, char8_t>);
+    // clang-format on
+
+    template <typename CharT>
+    using __match = std::pair<const CharT*, const CharT*>;
+
+    // matches a character or a string.
+    template <typename CharT>
+    class __delimiter {
+    public:
+        __delimiter() = default;
+
+        constexpr explicit __delimiter(CharT c)
+            : pattern_(1, c)
+        {
+        }
+
+        constexpr explicit __delimiter(std::basic_string_view<CharT> pattern)
+            : pattern_(pattern)
+        {
+        }
+
+        constexpr __match<CharT> find(const CharT* first,
+                                      const CharT* last) const
+        {
+            // like `std::views::split`, an empty pattern splits the range
+            // into single characters.
+            if (pattern_.empty()) {
+                return first != last ? __match<CharT>(first + 1, first + 1)
+                                     : __match<CharT>(last, last);
+            }
+
+            auto found = pattern_.size() == 1
+                ? iris::__detail::__find_char(first, last, pattern_.front())
+                : iris::__detail::__find_string(
+                    first, last, std::basic_string_view<CharT>(pattern_));
+            return { found,
+                     found != last ? found + pattern_.size() : found };
+        }
+
+    private:
+        std::basic_string<CharT> pattern_;
+    };
+
+    // matches any character of a set.
+    template <typename CharT>
+    class __any_delimiter {
+    public:
+        __any_delimiter() = default;
+
+        constexpr explicit __any_delimiter(
+            std::basic_string_view<CharT> delimiters)
+            : delimiters_(delimiters)
+        {
+        }
+
+        constexpr __match<CharT> find(const CharT* first,
+                                      const CharT* last) const
+        {
+            auto found = delimiters_.find_first_of(first, last);
+            return { found, found != last ? found + 1 : found };
+        }
+
+    private:
+        iris::__detail::__char_set<CharT> delimiters_;
+    };
+}
+
+// splits a contiguous range of characters into the `std::basic_string_view`s
+// between the delimiters found by `Delimiter`. unlike `std::views::split`,
+// which compares the elements one at a time, the delimiters are searched for
+// with `memchr` or, for a set of delimiters, a block of 16 characters at a
+// time where SSE2 is available.
+template <std::ranges::view View, typename Delimiter>
+    requires __split_view_detail::__char_range<View>
+class split_view
+    : public std::ranges::view_interface<split_view<View, Delimiter>> {
+    using CharT = std::ranges::range_value_t<View>;
+    using Match = __split_view_detail::__match<CharT>;
+
+public:
+    class iterator {
+        friend class split_view;
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::basic_string_view<CharT>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr value_type operator*() const
+        {
+            return value_type(current_,
+                              static_cast<std::size_t>(next_.first
+                                                       - current_));
+        }
+
+        constexpr iterator& operator++()
+        {
+            current_ = next_.first;
+            if (current_ != last_) {
+                current_ = next_.second;
+                if (current_ == last_) {
+                    trailing_empty_ = true;
+                    next_ = { current_, current_ };
+                } else {
+                    next_ = parent_->delimiter_.find(current_, last_);
+                }
+            } else {
+                trailing_empty_ = false;
+            }
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+        {
+            return lhs.current_ == rhs.current_
+                && lhs.trailing_empty_ == rhs.trailing_empty_;
+        }
+
+    private:
+        constexpr iterator(const split_view& parent,
+                           const CharT* current,
+                           const CharT* last,
+                           Match next)
+            : parent_(std::addressof(parent))
+            , current_(current)
+            , last_(last)
+            , next_(next)
+        {
+        }
+
+        const split_view* parent_ = nullptr;
+        const CharT* current_ = nullptr;
+        const CharT* last_ = nullptr;
+        Match next_ {};
+        bool trailing_empty_ = false;
+    };
+
+    split_view() requires std::default_initializable<View>
+    = default;
+
+    constexpr split_view(View base, Delimiter delimiter)
+        : base_(std::move(base))
+        , delimiter_(std::move(delimiter))
+    {
+    }
+
+    constexpr View base() const& requires std::copy_constructible<View>
+    {
+        return base_;
+    }
+
+    constexpr View base() &&
+    {
+        return std::move(base_);
+    }
+
+    constexpr iterator begin() const
+        requires __split_view_detail::__char_range<const View>
+    {
+        const CharT* first = std::ranges::data(base_);
+        const CharT* last = first + std::ranges::size(base_);
+        return iterator(*this, first, last, delimiter_.find(first, last));
+    }
+
+    constexpr iterator end() const
+        requires __split_view_detail::__char_range<const View>
+    {
+        const CharT* last
+            = std::ranges::data(base_) + std::ranges::size(base_);
+        return iterator(*this, last, last, Match(last, last));
+    }
+
+private:
+    View base_ {};
+    Delimiter delimiter_ {};
+};
+
+template <typename Range, typename Delimiter>
+split_view(Range&&, Delimiter)
+    -> split_view<std::views::all_t<Range>, Delimiter>;
+
+namespace views {
+    template <template <typename> typename Delimiter>
+    class __split_fn {
+    public:
+        // clang-format off
+        template <std::ranges::viewable_range Range, typename Pattern>
+            requires __split_view_detail::__char_range<Range>
+                && std::constructible_from<
+                    Delimiter<std::ranges::range_value_t<Range>>, Pattern>
+        constexpr auto operator()(Range&& range, Pattern&& pattern) const
+        // clang-format on
+        {
+            return split_view(std::forward<Range>(range),
+                              Delimiter<std::ranges::range_value_t<Range>>(
+                                  std::forward<Pattern>(pattern)));
+        }
+
+        template <typename Pattern>
+        constexpr auto operator()(Pattern&& pattern) const //
+            noexcept(std::is_nothrow_constructible_v<std::decay_t<Pattern>,
+                                                     Pattern>) //
+            requires std::constructible_from<std::decay_t<Pattern>, Pattern>
+        {
+            return range_adaptor_closure(
+                bind_back(*this, std::forward<Pattern>(pattern)));
+        }
+    };
+
+    // splits by a character or a string.
+    inline constexpr __split_fn<__split_view_detail::__delimiter> split {};
+
+    // splits by any character of a set.
+    inline constexpr __split_fn<__split_view_detail::__any_delimiter>
+        split_any {};
+}
+}
+
+namespace iris {
+namespace views = ranges::views;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+
+namespace iris {
+
+// a scheduler which runs the coroutines scheduled on it on the thread
+// calling `run()`, in FIFO order.
+class run_loop {
+    struct __operation {
+        std::coroutine_handle<> handle_;
+        __operation* next_ = nullptr;
+    };
+
+public:
+    run_loop() = default;
+
+    run_loop(const run_loop&) = delete;
+
+    run_loop& operator=(const run_loop&) = delete;
+
+    ~run_loop() noexcept
+    {
+        IRIS_ASSERT(head_ == nullptr);
+    }
+
+    // resumes the awaiting coroutine on the thread running the loop.
+    // thread-safe.
+    auto schedule() noexcept
+    {
+        class awaitable : private __operation {
+        public:
+            explicit awaitable(run_loop& loop) noexcept
+                : loop_(loop)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                loop_.__push(*this);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            run_loop& loop_;
+        };
+
+        return awaitable(*this);
+    }
+
+    // resumes the scheduled coroutines on the calling thread until
+    // `finish()` is called and no coroutine is left. the loop can be run
+    // again afterwards.
+    void run()
+    {
+        while (auto op = __pop()) {
+            op->handle_.resume();
+        }
+    }
+
+    // makes `run()` return once it has run out of coroutines. thread-safe.
+    void finish() noexcept
+    {
+        // notifies under the lock, as the loop may be destroyed as soon as
+        // `run()` returns.
+        std::unique_lock lock(mutex_);
+        finishing_ = true;
+        cv_.notify_all();
+    }
+
+private:
+    void __push(__operation& op) noexcept
+    {
+        std::unique_lock lock(mutex_);
+        if (tail_ != nullptr) {
+            tail_->next_ = &op;
+        } else {
+            head_ = &op;
+        }
+        tail_ = &op;
+        cv_.notify_one();
+    }
+
+    __operation* __pop()
+    {
+        std::unique_lock lock(mutex_);
+        while (head_ == nullptr) {
+            if (finishing_) {
+                finishing_ = false;
+                return nullptr;
+            }
+            cv_.wait(lock);
+        }
+
+        auto op = head_;
+        head_ = op->next_;
+        if (head_ == nullptr) {
+            tail_ = nullptr;
+        }
+        return op;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    __operation* head_ = nullptr;
+    __operation* tail_ = nullptr;
+    bool finishing_ = false;
+};
+
+}
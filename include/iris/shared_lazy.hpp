@@ -0,0 +1,289 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace iris {
+
+template <typename T = void>
+class shared_lazy;
+
+namespace __shared_lazy_detail {
+    struct __awaiter_node {
+        std::coroutine_handle<> continuation_;
+        __awaiter_node* next_ = nullptr;
+    };
+
+    class __shared_lazy_promise_type_common {
+    public:
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_always();
+        }
+
+        auto final_suspend() noexcept
+        {
+            class awaitable {
+            public:
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<>) noexcept
+                {
+                    auto& promise = *promise_;
+                    auto* node = static_cast<__awaiter_node*>(
+                        promise.state_.exchange(promise.__ready_state(),
+                                                std::memory_order_acq_rel));
+
+                    // the shared state may be destroyed by any resumed
+                    // awaiter, only touch local variables from here on.
+                    while (node != nullptr && node->next_ != nullptr) {
+                        auto* next = node->next_;
+                        node->continuation_.resume();
+                        node = next;
+                    }
+
+                    if (node != nullptr) {
+                        return node->continuation_;
+                    }
+
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept { }
+
+                __shared_lazy_promise_type_common* promise_;
+            };
+
+            return awaitable { this };
+        }
+
+        void unhandled_exception() noexcept
+        {
+            exception_ = std::current_exception();
+        }
+
+        bool ready() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == __ready_state();
+        }
+
+        // returns false if the result is already available, otherwise
+        // `node` is enqueued and will be resumed once the result is set.
+        bool try_enqueue(__awaiter_node& node, bool& start) noexcept
+        {
+            auto state = state_.load(std::memory_order_acquire);
+            if (state == nullptr
+                && state_.compare_exchange_strong(
+                    state, &node, std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+                start = true;
+                return true;
+            }
+
+            do {
+                if (state == __ready_state()) {
+                    return false;
+                }
+
+                node.next_ = static_cast<__awaiter_node*>(state);
+            } while (!state_.compare_exchange_weak(state, &node,
+                                                   std::memory_order_release,
+                                                   std::memory_order_acquire));
+
+            return true;
+        }
+
+        void add_ref() noexcept
+        {
+            ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool release() noexcept
+        {
+            return ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        void rethrow_if_exception() const
+        {
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+        }
+
+    private:
+        void* __ready_state() const noexcept
+        {
+            return const_cast<__shared_lazy_promise_type_common*>(this);
+        }
+
+        // `nullptr` if the coroutine has not been started yet, `this` if the
+        // result is ready, otherwise the head of the awaiter list.
+        std::atomic<void*> state_ { nullptr };
+        std::atomic<std::size_t> ref_count_ { 1 };
+        std::exception_ptr exception_;
+    };
+
+    template <typename T>
+    class __shared_lazy_promise_type_base
+        : public __shared_lazy_promise_type_common {
+    public:
+        template <typename U = T>
+        void return_value(U&& value) requires std::convertible_to<U, T>
+        {
+            value_.emplace(std::forward<U>(value));
+        }
+
+        const T& result() const
+        {
+            rethrow_if_exception();
+            return *value_;
+        }
+
+    private:
+        std::optional<T> value_;
+    };
+
+    template <>
+    class __shared_lazy_promise_type_base<void>
+        : public __shared_lazy_promise_type_common {
+    public:
+        void return_void() noexcept { }
+
+        void result() const
+        {
+            rethrow_if_exception();
+        }
+    };
+
+    template <typename T>
+    class __shared_lazy_promise_type
+        : public __shared_lazy_promise_type_base<T> {
+    public:
+        shared_lazy<T> get_return_object() noexcept;
+    };
+}
+
+template <typename T>
+class [[nodiscard]] shared_lazy {
+public:
+    using promise_type = __shared_lazy_detail::__shared_lazy_promise_type<T>;
+    using value_type = T;
+
+    shared_lazy() noexcept = default;
+
+    shared_lazy(const shared_lazy& other) noexcept
+        : handle_(other.handle_)
+    {
+        if (handle_) {
+            handle_.promise().add_ref();
+        }
+    }
+
+    shared_lazy(shared_lazy&& other) noexcept
+        : handle_(std::exchange(other.handle_, {}))
+    {
+    }
+
+    ~shared_lazy() noexcept
+    {
+        reset();
+    }
+
+    shared_lazy& operator=(shared_lazy other) noexcept
+    {
+        std::swap(handle_, other.handle_);
+        return *this;
+    }
+
+    bool ready() const noexcept
+    {
+        return !handle_ || handle_.promise().ready();
+    }
+
+    auto operator co_await() const noexcept
+    {
+        class awaitable {
+        public:
+            awaitable(std::coroutine_handle<promise_type> handle)
+                : handle_(handle)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return handle_.promise().ready();
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                // `this` may be resumed and destroyed by another thread as
+                // soon as it is enqueued.
+                auto body = handle_;
+                node_.continuation_ = handle;
+                bool start = false;
+                if (!body.promise().try_enqueue(node_, start)) {
+                    return handle;
+                }
+
+                if (start) {
+                    return body;
+                }
+
+                return std::noop_coroutine();
+            }
+
+            decltype(auto) await_resume()
+            {
+                return handle_.promise().result();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> handle_;
+            __shared_lazy_detail::__awaiter_node node_;
+        };
+
+        IRIS_ASSERT(handle_);
+        return awaitable(handle_);
+    }
+
+private:
+    friend class __shared_lazy_detail::__shared_lazy_promise_type<T>;
+
+    explicit shared_lazy(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    void reset() noexcept
+    {
+        if (auto handle = std::exchange(handle_, {});
+            handle && handle.promise().release()) {
+            handle.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace __shared_lazy_detail {
+    template <typename T>
+    shared_lazy<T> __shared_lazy_promise_type<T>::get_return_object() noexcept
+    {
+        return shared_lazy<T>(
+            std::coroutine_handle<__shared_lazy_promise_type<T>>::from_promise(
+                *this));
+    }
+}
+
+}
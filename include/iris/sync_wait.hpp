@@ -0,0 +1,44 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <iris/__detail/sync_wait.hpp>
+#include <iris/coroutine.hpp>
+#include <iris/run_loop.hpp>
+
+#include <concepts>
+
+namespace iris {
+
+// awaits `obj` on the calling thread and blocks until it completes,
+// returning its result or rethrowing its exception.
+template <typename Awaitable>
+awaitable_result_t<Awaitable>
+sync_wait(Awaitable&& obj) requires awaitable<Awaitable>
+{
+    run_loop loop;
+    auto task = __detail::__sync_wait_impl(std::forward<Awaitable>(obj));
+    task.start(loop);
+    return task.result();
+}
+
+// awaits `obj` on `scheduler` and blocks until it completes. if `scheduler`
+// is a `run_loop`, the calling thread runs it until then, so that a whole
+// program can be driven from `main()`. the loop must not be run by any other
+// thread meanwhile.
+template <typename Scheduler, typename Awaitable>
+    requires awaitable<Awaitable> && requires(Scheduler& s) { s.schedule(); }
+awaitable_result_t<Awaitable> sync_wait(Scheduler& scheduler, Awaitable&& obj)
+{
+    auto task = __detail::__sync_wait_on(scheduler,
+                                         std::forward<Awaitable>(obj));
+    if constexpr (std::same_as<Scheduler, run_loop>) {
+        task.start(scheduler);
+    } else {
+        run_loop loop;
+        task.start(loop);
+    }
+    return task.result();
+}
+
+}
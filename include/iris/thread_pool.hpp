@@ -0,0 +1,136 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iris {
+
+// a scheduler which resumes the coroutines scheduled on it on a fixed set of
+// worker threads, in FIFO order.
+class thread_pool {
+    struct __operation {
+        std::coroutine_handle<> handle_;
+        __operation* next_ = nullptr;
+    };
+
+public:
+    explicit thread_pool(std::size_t size = std::max(
+                             1u, std::thread::hardware_concurrency()))
+    {
+        IRIS_ASSERT(size > 0);
+        threads_.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            threads_.emplace_back([this] { __run(); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // resumes the coroutines which are still scheduled before joining the
+    // worker threads.
+    ~thread_pool() noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    // resumes the awaiting coroutine on one of the worker threads.
+    // thread-safe.
+    auto schedule() noexcept
+    {
+        class awaitable : private __operation {
+        public:
+            explicit awaitable(thread_pool& pool) noexcept
+                : pool_(pool)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                pool_.__push(*this);
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            thread_pool& pool_;
+        };
+
+        return awaitable(*this);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return threads_.size();
+    }
+
+private:
+    void __push(__operation& op) noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            if (tail_ != nullptr) {
+                tail_->next_ = &op;
+            } else {
+                head_ = &op;
+            }
+            tail_ = &op;
+        }
+        cv_.notify_one();
+    }
+
+    void __run()
+    {
+        for (;;) {
+            __operation* op = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                while (head_ == nullptr) {
+                    if (stopping_) {
+                        return;
+                    }
+                    cv_.wait(lock);
+                }
+
+                op = head_;
+                head_ = op->next_;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+            }
+
+            op->handle_.resume();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    __operation* head_ = nullptr;
+    __operation* tail_ = nullptr;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#if defined(__linux__)
+
+#include <iris/expected.hpp>
+#include <iris/io_context.hpp>
+#include <iris/lazy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace iris {
+
+struct timeout_error {
+    friend bool operator==(const timeout_error&, const timeout_error&)
+        = default;
+};
+
+namespace __timeout_detail {
+    class __driver {
+    public:
+        class promise_type {
+        public:
+            __driver get_return_object() noexcept
+            {
+                return __driver(
+                    std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            auto initial_suspend() noexcept
+            {
+                return std::suspend_always();
+            }
+
+            auto final_suspend() noexcept
+            {
+                return std::suspend_never();
+            }
+
+            void return_void() noexcept { }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+
+        void start() noexcept
+        {
+            std::exchange(handle_, {}).resume();
+        }
+
+    private:
+        explicit __driver(std::coroutine_handle<promise_type> handle) noexcept
+            : handle_(handle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    // shared by the awaiting coroutine, the coroutine driving the task and
+    // the timer. whichever of the task and the timer finishes first resumes
+    // the awaiting coroutine, the other one only releases its reference.
+    template <typename T>
+    class __state {
+    public:
+        enum class __winner : int { none, task, timer };
+
+        __state(io_context& context, lazy<T> task) noexcept
+            : context_(context)
+            , task_(std::move(task))
+        {
+            timer_.self_ = this;
+            timer_.context_ = &context;
+            timer_.fire_ = [](__detail::__timer_node* node) noexcept {
+                static_cast<__timer*>(node)->self_->__on_timeout();
+            };
+            cancel_.self_ = this;
+            cancel_.perform_ = [](__io_detail::__operation* op) noexcept {
+                auto* self = static_cast<__cancel_operation*>(op)->self_;
+                self->__cancel_timer();
+                self->release();
+                return true;
+            };
+        }
+
+        void start(std::coroutine_handle<> continuation,
+                   std::chrono::steady_clock::time_point deadline) noexcept
+        {
+            // the reference of the awaitable is taken at construction, add
+            // the ones of the timer and the driver.
+            refs_.fetch_add(2, std::memory_order_relaxed);
+            continuation_ = continuation;
+            context_.__add_timer(timer_, deadline);
+            __drive(this).start();
+        }
+
+        void release() noexcept
+        {
+            if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        expected<T, timeout_error> result()
+        {
+            if (winner_.load(std::memory_order_acquire) == __winner::timer) {
+                return unexpected(timeout_error {});
+            }
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+
+            return std::move(*value_);
+        }
+
+    private:
+        struct __timer : __io_detail::__timer {
+            __state* self_ = nullptr;
+        };
+
+        struct __cancel_operation : __io_detail::__operation {
+            __state* self_ = nullptr;
+        };
+
+        static __driver __drive(__state* self)
+        {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    co_await self->task_;
+                    self->value_.emplace();
+                } else {
+                    self->value_.emplace(std::in_place,
+                                         co_await self->task_);
+                }
+            } catch (...) {
+                self->exception_ = std::current_exception();
+            }
+
+            self->__on_completion();
+            self->release();
+        }
+
+        bool __try_win(__winner winner) noexcept
+        {
+            auto expected = __winner::none;
+            return winner_.compare_exchange_strong(expected, winner,
+                                                   std::memory_order_acq_rel);
+        }
+
+        void __on_completion() noexcept
+        {
+            if (!__try_win(__winner::task)) {
+                return;
+            }
+
+            // the timer can only be disarmed on the event loop.
+            if (context_.running_in_this_thread()) {
+                __cancel_timer();
+            } else {
+                refs_.fetch_add(1, std::memory_order_relaxed);
+                context_.post(cancel_);
+            }
+
+            continuation_.resume();
+        }
+
+        void __on_timeout() noexcept
+        {
+            if (__try_win(__winner::timer)) {
+                continuation_.resume();
+            }
+            release();
+        }
+
+        void __cancel_timer() noexcept
+        {
+            if (context_.__cancel_timer(timer_)) {
+                release();
+            }
+        }
+
+        io_context& context_;
+        lazy<T> task_;
+        std::atomic<int> refs_ = 1;
+        std::atomic<__winner> winner_ = __winner::none;
+        std::coroutine_handle<> continuation_;
+        std::optional<expected<T, timeout_error>> value_;
+        std::exception_ptr exception_;
+        __timer timer_;
+        __cancel_operation cancel_;
+    };
+}
+
+// awaits `task`, or resumes the awaiting coroutine with `timeout_error` if
+// `task` does not complete within `duration`. a task that times out keeps
+// running detached and its result is discarded. the awaiting coroutine is
+// resumed on the thread completing `task`, or on the event loop of
+// `context` on timeout.
+template <typename T>
+auto with_timeout(io_context& context,
+                  lazy<T> task,
+                  std::chrono::nanoseconds duration)
+{
+    class awaitable {
+    public:
+        awaitable(io_context& context,
+                  lazy<T> task,
+                  std::chrono::nanoseconds duration)
+            : state_(new __timeout_detail::__state<T>(context, std::move(task)))
+            , duration_(duration)
+        {
+        }
+
+        awaitable(const awaitable&) = delete;
+
+        awaitable& operator=(const awaitable&) = delete;
+
+        ~awaitable() noexcept
+        {
+            state_->release();
+        }
+
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            // the awaiting coroutine may be resumed before `start()`
+            // returns, `*this` must not be touched afterwards.
+            state_->start(handle, std::chrono::steady_clock::now() + duration_);
+        }
+
+        expected<T, timeout_error> await_resume()
+        {
+            return state_->result();
+        }
+
+    private:
+        __timeout_detail::__state<T>* state_;
+        std::chrono::nanoseconds duration_;
+    };
+
+    return awaitable(context, std::move(task), duration);
+}
+
+}
+
+#endif
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <iris/config.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iris {
+
+enum class trace_event_kind : std::uint8_t {
+    create,
+    resume,
+    suspend,
+    complete,
+};
+
+struct trace_event {
+    trace_event_kind kind;
+    // the kind of coroutine, e.g. "lazy".
+    const char* name;
+    const void* frame;
+    std::uint32_t thread;
+    // nanoseconds since the epoch of `std::chrono::steady_clock`.
+    std::uint64_t timestamp;
+};
+
+namespace __detail {
+    // a ring buffer written by a single thread. the oldest events are
+    // overwritten once it is full. readers copy the slots and discard the
+    // ones which may have been overwritten while copying.
+    class __trace_buffer {
+    public:
+        static constexpr std::size_t capacity = std::size_t(1) << 16;
+
+        explicit __trace_buffer(std::uint32_t thread) noexcept
+            : thread_(thread)
+        {
+        }
+
+        void push(trace_event_kind kind,
+                  const char* name,
+                  const void* frame) noexcept
+        {
+            auto head = head_.load(std::memory_order_relaxed);
+            auto& slot = slots_[head % capacity];
+            slot.kind_.store(kind, std::memory_order_relaxed);
+            slot.name_.store(name, std::memory_order_relaxed);
+            slot.frame_.store(frame, std::memory_order_relaxed);
+            slot.timestamp_.store(
+                static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count()),
+                std::memory_order_relaxed);
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        void snapshot(std::vector<trace_event>& events) const
+        {
+            auto head = head_.load(std::memory_order_acquire);
+            auto first = head > capacity ? head - capacity : 0;
+            auto offset = events.size();
+            for (auto i = first; i < head; ++i) {
+                auto& slot = slots_[i % capacity];
+                events.push_back({
+                    slot.kind_.load(std::memory_order_relaxed),
+                    slot.name_.load(std::memory_order_relaxed),
+                    slot.frame_.load(std::memory_order_relaxed),
+                    thread_,
+                    slot.timestamp_.load(std::memory_order_relaxed),
+                });
+            }
+
+            // drop the slots the writer may have reused in the meantime,
+            // including the one it may be writing to right now.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto last = head_.load(std::memory_order_relaxed) + 1;
+            if (last - first > capacity) {
+                auto overwritten = std::min<std::size_t>(
+                    last - first - capacity, head - first);
+                events.erase(events.begin() + offset,
+                             events.begin() + offset + overwritten);
+            }
+        }
+
+    private:
+        struct __slot {
+            std::atomic<trace_event_kind> kind_;
+            std::atomic<const char*> name_;
+            std::atomic<const void*> frame_;
+            std::atomic<std::uint64_t> timestamp_;
+        };
+
+        const std::uint32_t thread_;
+        std::atomic<std::size_t> head_ { 0 };
+        __slot slots_[capacity];
+    };
+
+    // owns the buffers of all threads which have recorded events, so that
+    // events outlive the threads recording them.
+    class __trace_registry {
+    public:
+        static __trace_registry& instance()
+        {
+            static __trace_registry registry;
+            return registry;
+        }
+
+        __trace_buffer& local()
+        {
+            thread_local __trace_buffer* buffer = __register();
+            return *buffer;
+        }
+
+        std::vector<trace_event> snapshot() const
+        {
+            std::vector<trace_event> events;
+            std::unique_lock lock(mutex_);
+            for (auto& buffer : buffers_) {
+                buffer->snapshot(events);
+            }
+
+            // skip the events recorded before the last `clear()`.
+            std::erase_if(events, [&](const auto& event) {
+                return event.timestamp < cleared_at_;
+            });
+
+            std::stable_sort(events.begin(), events.end(),
+                             [](const auto& lhs, const auto& rhs) {
+                                 return lhs.timestamp < rhs.timestamp;
+                             });
+            return events;
+        }
+
+        void clear()
+        {
+            std::unique_lock lock(mutex_);
+            cleared_at_ = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+
+    private:
+        __trace_buffer* __register()
+        {
+            std::unique_lock lock(mutex_);
+            auto thread = static_cast<std::uint32_t>(buffers_.size());
+            buffers_.push_back(std::make_unique<__trace_buffer>(thread));
+            return buffers_.back().get();
+        }
+
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<__trace_buffer>> buffers_;
+        std::uint64_t cleared_at_ = 0;
+    };
+
+    inline void __trace_emit(trace_event_kind kind,
+                             const void* frame,
+                             const char* name) noexcept
+    {
+        __trace_registry::instance().local().push(kind, name, frame);
+    }
+}
+
+// returns the recorded events of all threads ordered by time. each thread
+// keeps its latest `__detail::__trace_buffer::capacity` events.
+inline std::vector<trace_event> trace_snapshot()
+{
+    return __detail::__trace_registry::instance().snapshot();
+}
+
+// discards the events recorded so far.
+inline void trace_clear()
+{
+    __detail::__trace_registry::instance().clear();
+}
+
+// writes `events` in the Chrome trace event format, which can be loaded by
+// `chrome://tracing` and Perfetto. the time a coroutine is running becomes a
+// slice on the track of its thread, and its lifetime from creation to
+// completion becomes an async slice keyed by its frame address.
+inline void write_chrome_trace(std::ostream& os,
+                               std::span<const trace_event> events)
+{
+    auto origin = events.empty() ? 0 : events.front().timestamp;
+    bool first = true;
+
+    auto write = [&](const trace_event& event, char phase, bool async) {
+        auto ts = event.timestamp - origin;
+        os << (first ? "\n" : ",\n") << R"({"name":")" << event.name
+           << R"(","cat":"iris","ph":")" << phase << R"(","ts":)"
+           << ts / 1000 << '.' << (ts % 1000) / 100 << (ts % 100) / 10
+           << ts % 10 << R"(,"pid":1,"tid":)" << event.thread;
+        if (async) {
+            os << R"(,"id":")" << event.frame << '"';
+        } else {
+            os << R"(,"args":{"frame":")" << event.frame << R"("})";
+        }
+        os << '}';
+        first = false;
+    };
+
+    os << R"({"traceEvents":[)";
+    for (auto& event : events) {
+        switch (event.kind) {
+        case trace_event_kind::create:
+            write(event, 'b', true);
+            break;
+        case trace_event_kind::resume:
+            write(event, 'B', false);
+            break;
+        case trace_event_kind::suspend:
+            write(event, 'E', false);
+            break;
+        case trace_event_kind::complete:
+            write(event, 'E', false);
+            write(event, 'e', true);
+            break;
+        }
+    }
+    os << "\n]}\n";
+}
+
+namespace __detail {
+    // reports the first resumption of a coroutine.
+    class __traced_initial_suspend {
+    public:
+        explicit __traced_initial_suspend(const char* name) noexcept
+            : name_(name)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            frame_ = handle.address();
+        }
+
+        void await_resume() noexcept
+        {
+            __trace_emit(trace_event_kind::resume, frame_, name_);
+        }
+
+    private:
+        const char* name_;
+        const void* frame_ = nullptr;
+    };
+
+    // forwards to the awaiter of `Awaitable`, reporting the suspension and
+    // the resumption of the awaiting coroutine.
+    template <typename Awaitable>
+    class __traced_awaitable {
+        template <typename T>
+        static decltype(auto) __get_awaiter(T&& t)
+        {
+            if constexpr (requires { std::forward<T>(t).operator co_await(); }) {
+                return std::forward<T>(t).operator co_await();
+            } else if constexpr (requires {
+                                     operator co_await(std::forward<T>(t));
+                                 }) {
+                return operator co_await(std::forward<T>(t));
+            } else {
+                return std::forward<T>(t);
+            }
+        }
+
+        using awaiter_type
+            = decltype(__get_awaiter(std::declval<Awaitable>()));
+
+    public:
+        __traced_awaitable(Awaitable&& awaitable, const char* name)
+            : awaiter_(__get_awaiter(std::forward<Awaitable>(awaitable)))
+            , name_(name)
+        {
+        }
+
+        bool await_ready()
+        {
+            return awaiter_.await_ready();
+        }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            frame_ = handle.address();
+            suspended_ = true;
+            __trace_emit(trace_event_kind::suspend, frame_, name_);
+
+            using result_type
+                = decltype(awaiter_.await_suspend(std::declval<
+                                                  std::coroutine_handle<Promise>>()));
+            if constexpr (std::is_same_v<result_type, bool>) {
+                // `*this` is still owned by the calling thread if the
+                // coroutine does not suspend.
+                auto frame = frame_;
+                auto name = name_;
+                if (!awaiter_.await_suspend(handle)) {
+                    __trace_emit(trace_event_kind::resume, frame, name);
+                    suspended_ = false;
+                    return false;
+                }
+                return true;
+            } else {
+                return awaiter_.await_suspend(handle);
+            }
+        }
+
+        decltype(auto) await_resume()
+        {
+            if (suspended_) {
+                __trace_emit(trace_event_kind::resume, frame_, name_);
+            }
+            return awaiter_.await_resume();
+        }
+
+    private:
+        awaiter_type awaiter_;
+        const char* name_;
+        const void* frame_ = nullptr;
+        bool suspended_ = false;
+    };
+}
+
+}
@@ -0,0 +1,548 @@
+#include <iris/async_file.hpp>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace iris {
+namespace __io_detail {
+    static std::error_code __last_error() noexcept
+    {
+        return std::error_code(errno, std::generic_category());
+    }
+
+    struct __uring {
+        explicit __uring(io_context& context, unsigned entries)
+            : context_(context)
+        {
+            io_uring_params params {};
+            fd_ = static_cast<int>(
+                ::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0) {
+                throw std::system_error(__last_error(), "io_uring_setup");
+            }
+
+            try {
+                __map(params);
+                __register_eventfd();
+            } catch (...) {
+                __close();
+                throw;
+            }
+        }
+
+        ~__uring() noexcept
+        {
+            __close();
+        }
+
+        void __close() noexcept
+        {
+            if (reaper_ != nullptr) {
+                context_.__deregister(reaper_);
+                ::close(reaper_->fd_);
+            }
+            __unmap();
+            ::close(fd_);
+        }
+
+        void submit(__file_operation& op) noexcept
+        {
+            // the submission ring and `pending_` are owned by the loop.
+            IRIS_ASSERT(context_.running_in_this_thread());
+            auto tail = *sq_tail_;
+            auto head
+                = std::atomic_ref(*sq_head_).load(std::memory_order_acquire);
+            if (tail - head == sq_entries_) {
+                // the submission ring is full, hand the pending entries to
+                // the kernel to make room.
+                __enter();
+                tail = *sq_tail_;
+                head = std::atomic_ref(*sq_head_).load(
+                    std::memory_order_acquire);
+                if (tail - head == sq_entries_) {
+                    op.error_ = EBUSY;
+                    context_.post(op);
+                    return;
+                }
+            }
+
+            auto index = tail & sq_mask_;
+            auto& sqe = sqes_[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            auto fixed = op.buffer_index_ >= 0;
+            if (op.opcode_ == __file_operation::__opcode::read) {
+                sqe.opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            } else {
+                sqe.opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+            }
+            sqe.fd = op.fd_;
+            sqe.off = op.offset_;
+            sqe.addr = reinterpret_cast<std::uint64_t>(op.data_);
+            // the length of an entry is 32 bits, larger requests complete
+            // short like an oversized `pread`/`pwrite` would.
+            sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(
+                op.size_, std::numeric_limits<std::uint32_t>::max()));
+            sqe.buf_index
+                = fixed ? static_cast<std::uint16_t>(op.buffer_index_) : 0;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&op);
+            sq_array_[index] = index;
+            std::atomic_ref(*sq_tail_).store(tail + 1,
+                                             std::memory_order_release);
+
+            // defer the submission to the end of the current event loop
+            // iteration so that operations started together are submitted
+            // with a single system call. `pending_` may drop to zero while
+            // the flush is still posted, so it is tracked separately.
+            ++pending_;
+            if (!flush_posted_) {
+                flush_posted_ = true;
+                context_.post(flush_);
+            }
+        }
+
+        expected<void, std::error_code>
+        register_buffers(std::span<const std::span<std::byte>> buffers)
+        {
+            unregister_buffers();
+
+            std::vector<iovec> iovecs;
+            iovecs.reserve(buffers.size());
+            for (auto& buffer : buffers) {
+                iovecs.push_back({ buffer.data(), buffer.size() });
+            }
+
+            if (::syscall(__NR_io_uring_register, fd_,
+                          IORING_REGISTER_BUFFERS, iovecs.data(),
+                          static_cast<unsigned>(iovecs.size()))
+                != 0) {
+                return unexpected(__last_error());
+            }
+
+            buffers_registered_ = true;
+            return {};
+        }
+
+        void unregister_buffers() noexcept
+        {
+            if (std::exchange(buffers_registered_, false)) {
+                ::syscall(__NR_io_uring_register, fd_,
+                          IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            }
+        }
+
+    private:
+        struct __flush_operation : __operation {
+            __uring* self_;
+        };
+
+        struct __reap_operation : __operation {
+            __uring* self_;
+        };
+
+        void __map(const io_uring_params& params)
+        {
+            sq_size_ = params.sq_off.array
+                + params.sq_entries * sizeof(std::uint32_t);
+            cq_size_ = params.cq_off.cqes
+                + params.cq_entries * sizeof(io_uring_cqe);
+            auto single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single) {
+                sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+            }
+
+            sq_ring_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd_,
+                              IORING_OFF_SQ_RING);
+            if (sq_ring_ == MAP_FAILED) {
+                sq_ring_ = nullptr;
+                throw std::system_error(__last_error(), "mmap");
+            }
+
+            if (single) {
+                cq_ring_ = sq_ring_;
+            } else {
+                cq_ring_ = ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, fd_,
+                                  IORING_OFF_CQ_RING);
+                if (cq_ring_ == MAP_FAILED) {
+                    cq_ring_ = nullptr;
+                    throw std::system_error(__last_error(), "mmap");
+                }
+            }
+
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+            auto sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, fd_,
+                               IORING_OFF_SQES);
+            if (sqes == MAP_FAILED) {
+                throw std::system_error(__last_error(), "mmap");
+            }
+            sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+            auto at = [](void* ring, std::uint32_t offset) {
+                return reinterpret_cast<std::uint32_t*>(
+                    static_cast<std::byte*>(ring) + offset);
+            };
+
+            sq_head_ = at(sq_ring_, params.sq_off.head);
+            sq_tail_ = at(sq_ring_, params.sq_off.tail);
+            sq_array_ = at(sq_ring_, params.sq_off.array);
+            sq_mask_ = *at(sq_ring_, params.sq_off.ring_mask);
+            sq_entries_ = params.sq_entries;
+
+            cq_head_ = at(cq_ring_, params.cq_off.head);
+            cq_tail_ = at(cq_ring_, params.cq_off.tail);
+            cq_mask_ = *at(cq_ring_, params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(
+                static_cast<std::byte*>(cq_ring_) + params.cq_off.cqes);
+        }
+
+        void __unmap() noexcept
+        {
+            if (sqes_ != nullptr) {
+                ::munmap(sqes_, sqes_size_);
+            }
+            if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+                ::munmap(cq_ring_, cq_size_);
+            }
+            if (sq_ring_ != nullptr) {
+                ::munmap(sq_ring_, sq_size_);
+            }
+        }
+
+        void __register_eventfd()
+        {
+            auto event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (event_fd < 0) {
+                throw std::system_error(__last_error(), "eventfd");
+            }
+
+            try {
+                reaper_ = context_.__register(event_fd);
+            } catch (...) {
+                ::close(event_fd);
+                throw;
+            }
+
+            if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_EVENTFD,
+                          &event_fd, 1)
+                != 0) {
+                throw std::system_error(__last_error(), "io_uring_register");
+            }
+
+            flush_.self_ = this;
+            flush_.perform_ = [](__operation* op) noexcept {
+                auto self = static_cast<__flush_operation*>(op)->self_;
+                self->flush_posted_ = false;
+                self->__enter();
+                return true;
+            };
+
+            // the reap operation stays parked on the eventfd for the whole
+            // lifetime of the ring, it never completes.
+            reap_.self_ = this;
+            reap_.perform_ = [](__operation* op) noexcept {
+                static_cast<__reap_operation*>(op)->self_->__reap();
+                return false;
+            };
+            __park(reaper_->read_, reap_);
+        }
+
+        void __enter() noexcept
+        {
+            while (pending_ > 0) {
+                auto n = ::syscall(__NR_io_uring_enter, fd_, pending_, 0, 0,
+                                   nullptr, 0);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    if (errno == EAGAIN || errno == EBUSY) {
+                        __reap();
+                        continue;
+                    }
+                    __fail_pending(errno);
+                    break;
+                }
+                pending_ -= static_cast<unsigned>(n);
+            }
+        }
+
+        // completes the entries which the kernel has not consumed with
+        // `error`, and takes them back out of the submission ring, so that
+        // later submissions are not stuck behind them.
+        void __fail_pending(int error) noexcept
+        {
+            auto head
+                = std::atomic_ref(*sq_head_).load(std::memory_order_acquire);
+            auto tail = *sq_tail_;
+            for (; head != tail; ++head) {
+                auto& sqe = sqes_[sq_array_[head & sq_mask_]];
+                auto* op = reinterpret_cast<__file_operation*>(sqe.user_data);
+                op->error_ = error;
+                context_.post(*op);
+            }
+            std::atomic_ref(*sq_tail_).store(head, std::memory_order_release);
+            pending_ = 0;
+        }
+
+        void __reap() noexcept
+        {
+            std::uint64_t value;
+            while (::read(reaper_->fd_, &value, sizeof(value)) > 0) {
+            }
+
+            auto head = *cq_head_;
+            for (;;) {
+                if (head
+                    == std::atomic_ref(*cq_tail_).load(
+                        std::memory_order_acquire)) {
+                    break;
+                }
+
+                auto& cqe = cqes_[head & cq_mask_];
+                auto* op = reinterpret_cast<__file_operation*>(cqe.user_data);
+                auto res = cqe.res;
+                std::atomic_ref(*cq_head_).store(++head,
+                                                 std::memory_order_release);
+
+                if (res < 0) {
+                    op->error_ = -res;
+                } else {
+                    op->result_ = static_cast<std::size_t>(res);
+                }
+                op->handle_.resume();
+            }
+        }
+
+        io_context& context_;
+        int fd_ = -1;
+        unsigned pending_ = 0;
+        bool flush_posted_ = false;
+        bool buffers_registered_ = false;
+
+        void* sq_ring_ = nullptr;
+        void* cq_ring_ = nullptr;
+        std::size_t sq_size_ = 0;
+        std::size_t cq_size_ = 0;
+        std::size_t sqes_size_ = 0;
+        io_uring_sqe* sqes_ = nullptr;
+        io_uring_cqe* cqes_ = nullptr;
+        std::uint32_t* sq_head_ = nullptr;
+        std::uint32_t* sq_tail_ = nullptr;
+        std::uint32_t* sq_array_ = nullptr;
+        std::uint32_t sq_mask_ = 0;
+        std::uint32_t sq_entries_ = 0;
+        std::uint32_t* cq_head_ = nullptr;
+        std::uint32_t* cq_tail_ = nullptr;
+        std::uint32_t cq_mask_ = 0;
+
+        __descriptor* reaper_ = nullptr;
+        __flush_operation flush_;
+        __reap_operation reap_;
+    };
+
+    struct __thread_pool {
+        explicit __thread_pool(unsigned threads)
+        {
+            workers_.reserve(threads);
+            for (unsigned i = 0; i < threads; ++i) {
+                workers_.emplace_back([this]() { __work(); });
+            }
+        }
+
+        ~__thread_pool() noexcept
+        {
+            {
+                std::unique_lock lock(mutex_);
+                stopped_ = true;
+            }
+            cv_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        void submit(__file_operation& op) noexcept
+        {
+            {
+                std::unique_lock lock(mutex_);
+                op.next_ = nullptr;
+                if (tail_ != nullptr) {
+                    tail_->next_ = &op;
+                } else {
+                    head_ = &op;
+                }
+                tail_ = &op;
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        void __work() noexcept
+        {
+            for (;;) {
+                __file_operation* op = nullptr;
+                {
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [this]() { return stopped_ || head_; });
+                    if (head_ == nullptr) {
+                        return;
+                    }
+                    op = static_cast<__file_operation*>(head_);
+                    head_ = op->next_;
+                    if (head_ == nullptr) {
+                        tail_ = nullptr;
+                    }
+                }
+
+                long n;
+                do {
+                    if (op->opcode_ == __file_operation::__opcode::read) {
+                        n = ::pread(op->fd_, op->data_, op->size_,
+                                    static_cast<off_t>(op->offset_));
+                    } else {
+                        n = ::pwrite(op->fd_, op->data_, op->size_,
+                                     static_cast<off_t>(op->offset_));
+                    }
+                } while (n < 0 && errno == EINTR);
+
+                if (n < 0) {
+                    op->error_ = errno;
+                } else {
+                    op->result_ = static_cast<std::size_t>(n);
+                }
+
+                op->context_->post(*op);
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        __operation* head_ = nullptr;
+        __operation* tail_ = nullptr;
+        bool stopped_ = false;
+        std::vector<std::thread> workers_;
+    };
+}
+
+file_service::file_service(io_context& context, unsigned entries)
+    : context_(context)
+{
+    try {
+        uring_ = std::make_unique<__io_detail::__uring>(context, entries);
+    } catch (const std::system_error&) {
+        pool_ = std::make_unique<__io_detail::__thread_pool>(
+            std::max(2u, std::thread::hardware_concurrency()));
+    }
+}
+
+file_service::file_service(io_context& context,
+                           file_backend backend,
+                           unsigned entries)
+    : context_(context)
+{
+    if (backend == file_backend::io_uring) {
+        uring_ = std::make_unique<__io_detail::__uring>(context, entries);
+    } else {
+        pool_ = std::make_unique<__io_detail::__thread_pool>(
+            std::max(2u, std::thread::hardware_concurrency()));
+    }
+}
+
+file_service::~file_service() noexcept = default;
+
+expected<void, std::error_code>
+file_service::register_buffers(std::span<const std::span<std::byte>> buffers)
+{
+    if (uring_) {
+        return uring_->register_buffers(buffers);
+    }
+
+    return {};
+}
+
+void file_service::unregister_buffers() noexcept
+{
+    if (uring_) {
+        uring_->unregister_buffers();
+    }
+}
+
+void file_service::submit(__io_detail::__file_operation& op) noexcept
+{
+    if (uring_) {
+        if (context_.running_in_this_thread()) {
+            uring_->submit(op);
+            return;
+        }
+
+        op.perform_ = [](__io_detail::__operation* op) noexcept {
+            auto& file_op = static_cast<__io_detail::__file_operation&>(*op);
+            file_op.perform_ = nullptr;
+            file_op.service_->submit(file_op);
+            return true;
+        };
+        context_.post(op);
+    } else {
+        pool_->submit(op);
+    }
+}
+
+expected<async_file, std::error_code> async_file::open(
+    file_service& service, const std::filesystem::path& path, file_mode mode)
+{
+    int flags = O_CLOEXEC;
+    switch (mode) {
+    case file_mode::read:
+        flags |= O_RDONLY;
+        break;
+    case file_mode::write:
+        flags |= O_WRONLY | O_CREAT | O_TRUNC;
+        break;
+    case file_mode::read_write:
+        flags |= O_RDWR | O_CREAT;
+        break;
+    }
+
+    auto fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    return async_file(service, fd);
+}
+
+void async_file::close() noexcept
+{
+    if (fd_ >= 0) {
+        ::close(std::exchange(fd_, -1));
+    }
+}
+
+expected<std::uint64_t, std::error_code> async_file::size() const noexcept
+{
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    return static_cast<std::uint64_t>(st.st_size);
+}
+
+}
+
+#endif
@@ -0,0 +1,508 @@
+#include <iris/io_context.hpp>
+
+#if defined(__linux__)
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace iris {
+namespace __io_detail {
+    bool __park(std::atomic<void*>& slot, __operation& op) noexcept
+    {
+        for (;;) {
+            slot.store(nullptr, std::memory_order_relaxed);
+            if (op.perform_(&op)) {
+                return false;
+            }
+
+            // an edge arriving after the failed attempt marks the slot
+            // ready, in which case the operation has to be retried.
+            void* expected = nullptr;
+            if (slot.compare_exchange_strong(expected, &op,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                return true;
+            }
+        }
+    }
+
+    void __signal(std::atomic<void*>& slot) noexcept
+    {
+        auto state
+            = slot.exchange(__descriptor::__ready(), std::memory_order_acq_rel);
+        if (state == nullptr || state == __descriptor::__ready()) {
+            return;
+        }
+
+        auto* op = static_cast<__operation*>(state);
+        if (!__park(slot, *op)) {
+            op->handle_.resume();
+        }
+    }
+
+    static std::error_code __last_error() noexcept
+    {
+        return std::error_code(errno, std::generic_category());
+    }
+
+    static sockaddr_in __to_sockaddr(const ipv4_endpoint& endpoint) noexcept
+    {
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(endpoint.port());
+        auto address = endpoint.address();
+        std::memcpy(&addr.sin_addr.s_addr, address.data(), address.size());
+        return addr;
+    }
+
+    static thread_local const io_context* __running = nullptr;
+
+    class __running_guard {
+    public:
+        explicit __running_guard(const io_context& context) noexcept
+            : previous_(std::exchange(__running, &context))
+        {
+        }
+
+        ~__running_guard() noexcept
+        {
+            __running = previous_;
+        }
+
+    private:
+        const io_context* previous_;
+    };
+
+    static ipv4_endpoint __from_sockaddr(const sockaddr_in& addr) noexcept
+    {
+        std::array<std::uint8_t, 4> address;
+        std::memcpy(address.data(), &addr.sin_addr.s_addr, address.size());
+        return ipv4_endpoint(address, ntohs(addr.sin_port));
+    }
+}
+
+io_context::io_context()
+{
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (epoll_fd_ < 0 || event_fd_ < 0 || timer_fd_ < 0) {
+        auto ec = __io_detail::__last_error();
+        for (auto fd : { timer_fd_, event_fd_, epoll_fd_ }) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        throw std::system_error(ec, "io_context");
+    }
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.ptr = &event_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &event);
+    event.data.ptr = &timer_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &event);
+}
+
+io_context::~io_context() noexcept
+{
+    while (retired_ != nullptr) {
+        delete std::exchange(retired_, retired_->next_);
+    }
+
+    for (auto fd : { timer_fd_, event_fd_, epoll_fd_ }) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+void io_context::run()
+{
+    __io_detail::__running_guard guard(*this);
+    while (!stopped()) {
+        __run_once(-1);
+    }
+}
+
+void io_context::run_for(std::chrono::nanoseconds duration)
+{
+    if (duration <= std::chrono::nanoseconds::zero()) {
+        poll();
+        return;
+    }
+
+    __io_detail::__running_guard guard(*this);
+
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+    itimerspec spec {};
+    spec.it_value.tv_sec = static_cast<time_t>(seconds.count());
+    spec.it_value.tv_nsec = static_cast<long>((duration - seconds).count());
+    ::timerfd_settime(timer_fd_, 0, &spec, nullptr);
+
+    timer_expired_ = false;
+    while (!stopped() && !timer_expired_) {
+        __run_once(-1);
+    }
+
+    spec = {};
+    ::timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+std::size_t io_context::poll()
+{
+    __io_detail::__running_guard guard(*this);
+    return __run_once(0);
+}
+
+bool io_context::running_in_this_thread() const noexcept
+{
+    return __io_detail::__running == this;
+}
+
+void io_context::__add_timer(
+    __io_detail::__timer& timer,
+    std::chrono::steady_clock::time_point deadline) noexcept
+{
+    // the expiry is rounded up so that timers never fire early.
+    timer.expiry_ = __to_tick(deadline + __timer_resolution(1)
+                              - std::chrono::nanoseconds(1));
+    timer.cancelled_ = false;
+    if (running_in_this_thread()) {
+        timers_.insert(timer, timer.expiry_);
+        return;
+    }
+
+    timer.perform_ = [](__io_detail::__operation* op) noexcept {
+        auto& timer = *static_cast<__io_detail::__timer*>(op);
+        if (timer.cancelled_) {
+            timer.fire_(&timer);
+        } else {
+            timer.context_->timers_.insert(timer, timer.expiry_);
+        }
+        return true;
+    };
+    post(timer);
+}
+
+bool io_context::__cancel_timer(__io_detail::__timer& timer) noexcept
+{
+    IRIS_ASSERT(running_in_this_thread());
+    if (!timer.linked()) {
+        // the insertion may still be posted.
+        timer.cancelled_ = true;
+        return false;
+    }
+
+    timers_.cancel(timer);
+    return true;
+}
+
+std::uint64_t io_context::__to_tick(
+    std::chrono::steady_clock::time_point time) const noexcept
+{
+    if (time <= epoch_) {
+        return 0;
+    }
+
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<__timer_resolution>(time - epoch_).count());
+}
+
+void io_context::stop() noexcept
+{
+    stopped_.store(true, std::memory_order_release);
+    std::uint64_t value = 1;
+    [[maybe_unused]] auto n = ::write(event_fd_, &value, sizeof(value));
+}
+
+void io_context::post(__io_detail::__operation& op) noexcept
+{
+    auto head = posted_.load(std::memory_order_relaxed);
+    do {
+        op.next_ = head;
+    } while (!posted_.compare_exchange_weak(
+        head, &op, std::memory_order_release, std::memory_order_relaxed));
+
+    // the event loop drains the whole list at once, only the first post
+    // after draining has to wake it up.
+    if (head == nullptr) {
+        std::uint64_t value = 1;
+        [[maybe_unused]] auto n = ::write(event_fd_, &value, sizeof(value));
+    }
+}
+
+std::size_t io_context::__run_posted() noexcept
+{
+    auto* op = posted_.exchange(nullptr, std::memory_order_acquire);
+
+    __io_detail::__operation* fifo = nullptr;
+    while (op != nullptr) {
+        auto* next = op->next_;
+        op->next_ = fifo;
+        fifo = op;
+        op = next;
+    }
+
+    std::size_t count = 0;
+    while (fifo != nullptr) {
+        auto* next = fifo->next_;
+        if (fifo->perform_) {
+            fifo->perform_(fifo);
+        } else {
+            fifo->handle_.resume();
+        }
+        fifo = next;
+        ++count;
+    }
+
+    return count;
+}
+
+std::size_t io_context::__run_once(int timeout)
+{
+    {
+        std::unique_lock lock(retired_mutex_);
+        while (retired_ != nullptr) {
+            delete std::exchange(retired_, retired_->next_);
+        }
+    }
+
+    auto count = __run_posted();
+    if (count > 0 || posted_.load(std::memory_order_acquire) != nullptr) {
+        timeout = 0;
+    } else if (!timers_.empty()) {
+        auto now = __to_tick(std::chrono::steady_clock::now());
+        auto next = timers_.next_tick();
+        auto wait = next > now ? static_cast<int>(std::min<std::uint64_t>(
+                        next - now, std::numeric_limits<int>::max()))
+                               : 0;
+        if (timeout < 0 || wait < timeout) {
+            timeout = wait;
+        }
+    }
+
+    epoll_event events[64];
+    auto n = ::epoll_wait(epoll_fd_, events, 64, timeout);
+    for (int i = 0; i < n; ++i) {
+        auto* ptr = events[i].data.ptr;
+        if (ptr == &event_fd_) {
+            std::uint64_t value;
+            [[maybe_unused]] auto r = ::read(event_fd_, &value, sizeof(value));
+        } else if (ptr == &timer_fd_) {
+            std::uint64_t value;
+            [[maybe_unused]] auto r = ::read(timer_fd_, &value, sizeof(value));
+            timer_expired_ = true;
+        } else {
+            auto* descriptor = static_cast<__io_detail::__descriptor*>(ptr);
+            auto flags = events[i].events;
+            if (flags & (EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+                __io_detail::__signal(descriptor->read_);
+                ++count;
+            }
+            if (flags & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+                __io_detail::__signal(descriptor->write_);
+                ++count;
+            }
+        }
+    }
+
+    count += timers_.advance(__to_tick(std::chrono::steady_clock::now()));
+    return count + __run_posted();
+}
+
+__io_detail::__descriptor* io_context::__register(int fd)
+{
+    auto* descriptor = new __io_detail::__descriptor;
+    descriptor->fd_ = fd;
+
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = descriptor;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        auto ec = __io_detail::__last_error();
+        delete descriptor;
+        throw std::system_error(ec, "epoll_ctl");
+    }
+
+    return descriptor;
+}
+
+void io_context::__deregister(__io_detail::__descriptor* descriptor) noexcept
+{
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor->fd_, nullptr);
+
+    // events of the descriptor may still be pending in the current batch,
+    // so it is released at the beginning of the next iteration.
+    std::unique_lock lock(retired_mutex_);
+    descriptor->next_ = retired_;
+    retired_ = descriptor;
+}
+
+socket::socket(io_context& context, int fd)
+    : context_(&context)
+{
+    auto flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        auto ec = __io_detail::__last_error();
+        ::close(fd);
+        throw std::system_error(ec, "fcntl");
+    }
+
+    try {
+        descriptor_ = context.__register(fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+expected<std::pair<socket, socket>, std::error_code>
+socket::open_pair(io_context& context)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    socket first(context, fds[0]);
+    socket second(context, fds[1]);
+    return std::pair<socket, socket>(std::move(first), std::move(second));
+}
+
+expected<socket, std::error_code> socket::open(io_context& context)
+{
+    auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    return socket(context, fd);
+}
+
+void socket::close() noexcept
+{
+    if (auto* descriptor = std::exchange(descriptor_, nullptr)) {
+        // operations parked on the descriptor would never be signalled
+        // again, they complete with `operation_canceled` instead.
+        for (auto* slot : { &descriptor->read_, &descriptor->write_ }) {
+            auto state = slot->exchange(nullptr, std::memory_order_acq_rel);
+            if (state != nullptr
+                && state != __io_detail::__descriptor::__ready()) {
+                auto* op = static_cast<__io_detail::__reactor_operation*>(
+                    static_cast<__io_detail::__operation*>(state));
+                op->cancel();
+                context_->post(*op);
+            }
+        }
+
+        auto fd = descriptor->fd_;
+        context_->__deregister(descriptor);
+        ::close(fd);
+    }
+}
+
+expected<ipv4_endpoint, std::error_code> socket::local_endpoint() const noexcept
+{
+    sockaddr_in addr {};
+    socklen_t size = sizeof(addr);
+    if (::getsockname(native_handle(), reinterpret_cast<sockaddr*>(&addr),
+                      &size)
+        != 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    return __io_detail::__from_sockaddr(addr);
+}
+
+long socket::__read(int fd, std::byte* data, std::size_t size) noexcept
+{
+    long n;
+    do {
+        n = ::read(fd, data, size);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+long socket::__write(int fd, const std::byte* data, std::size_t size) noexcept
+{
+    long n;
+    do {
+        n = ::send(fd, data, size, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+long socket::__connect(int fd,
+                       const ipv4_endpoint& endpoint,
+                       bool& started) noexcept
+{
+    auto addr = __io_detail::__to_sockaddr(endpoint);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr))
+        == 0) {
+        return 0;
+    }
+
+    switch (errno) {
+    case EISCONN:
+        if (started) {
+            return 0;
+        }
+        break;
+    case EINPROGRESS:
+    case EALREADY:
+        started = true;
+        errno = EAGAIN;
+        break;
+    default:
+        break;
+    }
+
+    return -1;
+}
+
+expected<void, std::error_code> acceptor::listen(const ipv4_endpoint& endpoint,
+                                                 int backlog)
+{
+    auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return unexpected(__io_detail::__last_error());
+    }
+
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    auto addr = __io_detail::__to_sockaddr(endpoint);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(fd, backlog) != 0) {
+        auto ec = __io_detail::__last_error();
+        ::close(fd);
+        return unexpected(ec);
+    }
+
+    socket_.emplace(context_, fd);
+    return {};
+}
+
+long acceptor::__accept(int fd) noexcept
+{
+    long n;
+    do {
+        n = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/__detail/timer_wheel.hpp>
+
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("timer_wheel");
+
+namespace {
+struct recording_timer : __detail::__timer_node {
+    recording_timer(std::vector<int>& fired, int id)
+        : fired_(fired)
+        , id_(id)
+    {
+        fire_ = [](__detail::__timer_node* node) noexcept {
+            auto* self = static_cast<recording_timer*>(node);
+            self->fired_.push_back(self->id_);
+        };
+    }
+
+    std::vector<int>& fired_;
+    int id_;
+};
+}
+
+TEST_CASE("insert and advance")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    recording_timer t0(fired, 0);
+    recording_timer t1(fired, 1);
+    recording_timer t2(fired, 2);
+
+    CHECK(wheel.empty());
+    wheel.insert(t1, 20);
+    wheel.insert(t0, 10);
+    wheel.insert(t2, 20);
+    CHECK_EQ(wheel.size(), 3);
+    CHECK_EQ(wheel.next_tick(), 10);
+
+    CHECK_EQ(wheel.advance(9), 0);
+    CHECK(fired.empty());
+    CHECK_EQ(wheel.advance(10), 1);
+    CHECK_EQ(fired, std::vector<int> { 0 });
+    CHECK_FALSE(t0.linked());
+    CHECK_EQ(wheel.advance(100), 2);
+    CHECK_EQ(fired, std::vector<int> { 0, 1, 2 });
+    CHECK(wheel.empty());
+    CHECK_EQ(wheel.now(), 100);
+}
+
+TEST_CASE("expired timers fire on the next tick")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    recording_timer t0(fired, 0);
+
+    wheel.advance(50);
+    wheel.insert(t0, 10);
+    CHECK_EQ(wheel.next_tick(), 51);
+    CHECK_EQ(wheel.advance(51), 1);
+}
+
+TEST_CASE("cancel")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    recording_timer t0(fired, 0);
+    recording_timer t1(fired, 1);
+
+    wheel.insert(t0, 5);
+    wheel.insert(t1, 5);
+    wheel.cancel(t0);
+    CHECK_FALSE(t0.linked());
+    CHECK_EQ(wheel.size(), 1);
+    wheel.cancel(t1);
+    CHECK(wheel.empty());
+    CHECK_EQ(wheel.advance(1000), 0);
+    CHECK(fired.empty());
+}
+
+TEST_CASE("cascade")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    std::vector<std::uint64_t> expiries {
+        255, 256, 257, 300, 65535, 65536, 70000, 1 << 24, (1 << 24) + 1,
+    };
+    std::vector<recording_timer> timers;
+    timers.reserve(expiries.size());
+    for (int i = static_cast<int>(expiries.size()) - 1; i >= 0; --i) {
+        timers.emplace_back(fired, i);
+    }
+    for (auto& timer : timers) {
+        wheel.insert(timer, expiries[timer.id_]);
+    }
+
+    for (std::size_t i = 0; i < expiries.size(); ++i) {
+        CHECK_EQ(wheel.advance(expiries[i] - 1), 0);
+        CHECK_EQ(wheel.advance(expiries[i]), 1);
+        CHECK_EQ(fired.back(), static_cast<int>(i));
+    }
+    CHECK(wheel.empty());
+}
+
+TEST_CASE("beyond the span of the wheel")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    recording_timer t0(fired, 0);
+    std::uint64_t expiry = (std::uint64_t(1) << 32) + 12345;
+
+    wheel.insert(t0, expiry);
+    CHECK_EQ(wheel.advance(expiry - 1), 0);
+    CHECK_EQ(wheel.advance(expiry), 1);
+}
+
+TEST_CASE("many timers")
+{
+    __detail::__timer_wheel wheel;
+    std::vector<int> fired;
+    std::vector<recording_timer> timers;
+    timers.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        timers.emplace_back(fired, i);
+        wheel.insert(timers.back(), static_cast<std::uint64_t>(i) * 97 + 1);
+    }
+
+    for (std::uint64_t tick = 0; tick < 100000; tick += 1000) {
+        wheel.advance(tick);
+    }
+    wheel.advance(100000);
+
+    CHECK_EQ(fired.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(fired[i], i);
+    }
+}
+
+TEST_SUITE_END();
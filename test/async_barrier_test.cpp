@@ -0,0 +1,79 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_barrier.hpp>
+
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_barrier");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached run_phases(async_barrier& barrier,
+                    std::vector<int>& phases,
+                    int count)
+{
+    for (int i = 0; i < count; ++i) {
+        phases.push_back(i);
+        co_await barrier.arrive_and_wait();
+    }
+}
+
+TEST_CASE("phases")
+{
+    async_barrier barrier(3);
+    std::vector<int> phases;
+    run_phases(barrier, phases, 2);
+    run_phases(barrier, phases, 2);
+    CHECK_EQ(phases, std::vector<int> { 0, 0 });
+
+    // the last participant completes the phase and resumes the others,
+    // which arrive at the next phase.
+    run_phases(barrier, phases, 2);
+    CHECK_EQ(phases, std::vector<int> { 0, 0, 0, 1, 1, 1 });
+}
+
+TEST_CASE("arrive_and_drop")
+{
+    async_barrier barrier(3);
+    std::vector<int> phases;
+    run_phases(barrier, phases, 3);
+    run_phases(barrier, phases, 3);
+    CHECK_EQ(phases.size(), 2);
+
+    // the remaining two participants complete the following phases on
+    // their own.
+    barrier.arrive_and_drop();
+    CHECK_EQ(phases, std::vector<int> { 0, 0, 1, 1, 2, 2 });
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,211 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_file.hpp>
+
+#if defined(__linux__)
+
+#include <fstream>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_file");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+class temporary_file {
+public:
+    temporary_file(std::size_t size)
+        : path_(std::filesystem::temp_directory_path()
+                / ("iris_async_file_test_" + std::to_string(::getpid())))
+    {
+        std::ofstream stream(path_, std::ios::binary);
+        for (std::size_t i = 0; i < size; ++i) {
+            stream.put(static_cast<char>(i % 251));
+        }
+    }
+
+    ~temporary_file()
+    {
+        std::filesystem::remove(path_);
+    }
+
+    const std::filesystem::path& path() const noexcept
+    {
+        return path_;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+constexpr std::size_t chunk_size = 4096;
+constexpr std::size_t chunk_count = 32;
+
+bool verify(std::span<const std::byte> chunk, std::size_t offset)
+{
+    for (std::size_t i = 0; i < chunk.size(); ++i) {
+        if (chunk[i] != static_cast<std::byte>((offset + i) % 251)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+detached read_chunk(async_file& file,
+                    std::span<std::byte> buffer,
+                    std::size_t offset,
+                    int buffer_index,
+                    std::size_t& completed,
+                    std::size_t& verified)
+{
+    auto n = co_await file.async_read_at(offset, buffer, buffer_index);
+    if (n && *n == buffer.size() && verify(buffer, offset)) {
+        ++verified;
+    }
+    if (++completed == chunk_count) {
+        file.close();
+    }
+}
+
+detached stop_when(io_context& context, const std::size_t& completed)
+{
+    while (completed < chunk_count) {
+        co_await context.schedule();
+    }
+    context.stop();
+}
+
+void read_concurrently(file_service& service, bool registered)
+{
+    temporary_file temp(chunk_size * chunk_count);
+    auto file = async_file::open(service, temp.path());
+    REQUIRE(file);
+    CHECK_EQ(file->size().value(), chunk_size * chunk_count);
+
+    std::vector<std::byte> storage(chunk_size * chunk_count);
+    if (registered) {
+        std::span<std::byte> buffers[] = { storage };
+        REQUIRE(service.register_buffers(buffers));
+    }
+
+    std::size_t completed = 0;
+    std::size_t verified = 0;
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+        read_chunk(*file,
+                   std::span(storage).subspan(i * chunk_size, chunk_size),
+                   i * chunk_size, registered ? 0 : -1, completed, verified);
+    }
+    stop_when(service.context(), completed);
+    service.context().run();
+
+    CHECK_EQ(completed, chunk_count);
+    CHECK_EQ(verified, chunk_count);
+    service.unregister_buffers();
+}
+
+detached write_then_read(async_file& file,
+                         io_context& context,
+                         std::string& result)
+{
+    std::string_view message = "hello async_file";
+    auto bytes = std::as_bytes(std::span(message.data(), message.size()));
+    auto written = co_await file.async_write_at(3, bytes);
+    CHECK_EQ(written.value(), message.size());
+
+    std::string buffer(message.size(), '\0');
+    auto read = co_await file.async_read_at(
+        3, std::as_writable_bytes(std::span(buffer.data(), buffer.size())));
+    CHECK_EQ(read.value(), message.size());
+    result = buffer;
+    context.stop();
+}
+
+void write_and_read(file_service& service)
+{
+    temporary_file temp(0);
+    auto file = async_file::open(service, temp.path(), file_mode::read_write);
+    REQUIRE(file);
+
+    std::string result;
+    write_then_read(*file, service.context(), result);
+    service.context().run();
+    CHECK_EQ(result, "hello async_file");
+    CHECK_EQ(file->size().value(), 3 + result.size());
+}
+
+std::optional<file_service> make_io_uring_service(io_context& context)
+{
+    try {
+        return std::optional<file_service>(std::in_place, context,
+                                           file_backend::io_uring);
+    } catch (const std::system_error&) {
+        MESSAGE("io_uring is not available");
+        return std::nullopt;
+    }
+}
+}
+
+TEST_CASE("io_uring backend")
+{
+    io_context context;
+    if (auto service = make_io_uring_service(context)) {
+        CHECK_EQ(service->backend(), file_backend::io_uring);
+        read_concurrently(*service, false);
+        context.restart();
+        read_concurrently(*service, true);
+        context.restart();
+        write_and_read(*service);
+    }
+}
+
+TEST_CASE("thread pool backend")
+{
+    io_context context;
+    file_service service(context, file_backend::thread_pool);
+    CHECK_EQ(service.backend(), file_backend::thread_pool);
+    read_concurrently(service, false);
+    context.restart();
+    read_concurrently(service, true);
+    context.restart();
+    write_and_read(service);
+}
+
+TEST_CASE("open non-existent file")
+{
+    io_context context;
+    file_service service(context);
+    auto file = async_file::open(service, "/non/existent/file");
+    REQUIRE(!file);
+    CHECK_EQ(file.error(), std::errc::no_such_file_or_directory);
+}
+
+TEST_SUITE_END();
+
+#endif
@@ -0,0 +1,141 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_generator.hpp>
+#include <iris/lazy.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_generator");
+
+lazy<int> square(int value)
+{
+    co_return value * value;
+}
+
+async_generator<int> squares(int start, int end)
+{
+    for (int i = start; i < end; ++i) {
+        co_yield co_await square(i);
+    }
+}
+
+lazy<std::vector<int>> collect(async_generator<int> gen)
+{
+    std::vector<int> result;
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+        result.push_back(*it);
+    }
+    co_return result;
+}
+
+TEST_CASE("co_await between co_yield")
+{
+    CHECK_EQ(collect(squares(0, 5)).sync_wait(),
+             std::vector<int> { 0, 1, 4, 9, 16 });
+}
+
+async_generator<const std::string&> yield_lvalue()
+{
+    std::string lvalue;
+    for (auto c : std::string("abc")) {
+        lvalue = c;
+        co_yield lvalue;
+    }
+}
+
+lazy<std::string> concat_strings()
+{
+    std::string result;
+    auto gen = yield_lvalue();
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+        result += *it;
+    }
+    co_return result;
+}
+
+TEST_CASE("co_yield lvalue for async_generator<const T&>")
+{
+    CHECK_EQ(concat_strings().sync_wait(), "abc");
+}
+
+async_generator<int> empty()
+{
+    co_return;
+}
+
+TEST_CASE("empty async_generator")
+{
+    CHECK(collect(empty()).sync_wait().empty());
+}
+
+async_generator<int> nested(int depth)
+{
+    co_yield depth;
+    if (depth > 0) {
+        co_yield ranges::elements_of(nested(depth - 1));
+    }
+    co_yield co_await square(depth);
+}
+
+TEST_CASE("co_yield elements_of(async_generator)")
+{
+    CHECK_EQ(collect(nested(2)).sync_wait(),
+             std::vector<int> { 2, 1, 0, 0, 1, 4 });
+}
+
+async_generator<int> yield_range()
+{
+    co_yield ranges::elements_of(std::views::iota(1, 4));
+    co_yield co_await square(4);
+}
+
+TEST_CASE("co_yield elements_of(range)")
+{
+    CHECK_EQ(collect(yield_range()).sync_wait(),
+             std::vector<int> { 1, 2, 3, 16 });
+}
+
+async_generator<int> throws_exception()
+{
+    co_yield 1;
+    throw std::runtime_error("async_generator");
+}
+
+async_generator<int> nested_throws_exception()
+{
+    bool caught = false;
+    try {
+        co_yield ranges::elements_of(throws_exception());
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    if (caught) {
+        co_yield 2;
+    }
+    co_yield ranges::elements_of(throws_exception());
+}
+
+lazy<std::vector<int>> collect_until_exception()
+{
+    std::vector<int> result;
+    try {
+        auto gen = nested_throws_exception();
+        for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+            result.push_back(*it);
+        }
+    } catch (const std::runtime_error&) {
+        result.push_back(-1);
+    }
+    co_return result;
+}
+
+TEST_CASE("async_generator body throws exception")
+{
+    CHECK_EQ(collect_until_exception().sync_wait(),
+             std::vector<int> { 1, 2, 1, -1 });
+}
+
+TEST_SUITE_END();
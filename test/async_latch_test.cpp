@@ -0,0 +1,94 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_latch.hpp>
+
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_latch");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached wait_and_record(async_latch& latch, std::vector<int>& order, int id)
+{
+    co_await latch.wait();
+    order.push_back(id);
+}
+
+detached arrive_and_record(async_latch& latch, std::vector<int>& order, int id)
+{
+    co_await latch.arrive_and_wait();
+    order.push_back(id);
+}
+
+TEST_CASE("wait")
+{
+    async_latch latch(2);
+    std::vector<int> order;
+    wait_and_record(latch, order, 0);
+    wait_and_record(latch, order, 1);
+    CHECK_FALSE(latch.try_wait());
+    CHECK(order.empty());
+
+    latch.count_down();
+    CHECK(order.empty());
+    latch.count_down();
+    CHECK(latch.try_wait());
+    CHECK_EQ(order.size(), 2);
+
+    wait_and_record(latch, order, 2);
+    CHECK_EQ(order.size(), 3);
+}
+
+TEST_CASE("arrive_and_wait")
+{
+    async_latch latch(3);
+    std::vector<int> order;
+    arrive_and_record(latch, order, 0);
+    arrive_and_record(latch, order, 1);
+    CHECK(order.empty());
+    // the last arrival resumes the waiters before it continues.
+    arrive_and_record(latch, order, 2);
+    CHECK_EQ(order.size(), 3);
+    CHECK_EQ(order.back(), 2);
+}
+
+TEST_CASE("zero")
+{
+    async_latch latch(0);
+    std::vector<int> order;
+    CHECK(latch.try_wait());
+    wait_and_record(latch, order, 0);
+    CHECK_EQ(order, std::vector<int> { 0 });
+}
+
+TEST_SUITE_END();
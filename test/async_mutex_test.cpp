@@ -0,0 +1,140 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_mutex.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_mutex");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+class manual_event {
+public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        waiter_ = handle;
+    }
+
+    void await_resume() noexcept { }
+
+    void set()
+    {
+        std::exchange(waiter_, {}).resume();
+    }
+
+private:
+    std::coroutine_handle<> waiter_;
+};
+
+}
+
+detached lock_and_record(async_mutex& mutex,
+                         manual_event& event,
+                         std::vector<int>& order,
+                         int id)
+{
+    co_await mutex.lock();
+    order.push_back(id);
+    co_await event;
+    mutex.unlock();
+}
+
+detached scoped_lock_and_record(async_mutex& mutex,
+                                std::vector<int>& order,
+                                int id)
+{
+    auto lock = co_await mutex.scoped_lock();
+    order.push_back(id);
+}
+
+detached increment(async_mutex& mutex, int& value, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        auto lock = co_await mutex.scoped_lock();
+        ++value;
+    }
+}
+
+TEST_CASE("try_lock")
+{
+    async_mutex mutex;
+    CHECK(mutex.try_lock());
+    CHECK_FALSE(mutex.try_lock());
+    mutex.unlock();
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST_CASE("fifo handoff")
+{
+    async_mutex mutex;
+    manual_event event;
+    std::vector<int> order;
+
+    lock_and_record(mutex, event, order, 0);
+    CHECK_EQ(order, std::vector<int> { 0 });
+    scoped_lock_and_record(mutex, order, 1);
+    scoped_lock_and_record(mutex, order, 2);
+    scoped_lock_and_record(mutex, order, 3);
+    CHECK_EQ(order, std::vector<int> { 0 });
+    CHECK_FALSE(mutex.try_lock());
+
+    event.set();
+    CHECK_EQ(order, std::vector<int> { 0, 1, 2, 3 });
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST_CASE("multiple threads")
+{
+    async_mutex mutex;
+    int value = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() { increment(mutex, value, 1000); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK_EQ(value, 4000);
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,319 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_scope.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+namespace {
+// makes the next allocation on this thread fail.
+thread_local bool fail_allocation = false;
+}
+
+void* operator new(std::size_t size)
+{
+    if (std::exchange(fail_allocation, false)) {
+        throw std::bad_alloc();
+    }
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// gcc cannot tell that the replaced `operator new` allocates with `malloc`.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+TEST_SUITE_BEGIN("async_scope");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+class manual_event {
+public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        waiter_ = handle;
+    }
+
+    void await_resume() noexcept { }
+
+    void set()
+    {
+        std::exchange(waiter_, {}).resume();
+    }
+
+private:
+    std::coroutine_handle<> waiter_;
+};
+
+class manual_scheduler {
+public:
+    auto schedule() noexcept
+    {
+        class awaitable {
+        public:
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                scheduler_.queue_.push_back(handle);
+            }
+
+            void await_resume() noexcept { }
+
+            manual_scheduler& scheduler_;
+        };
+
+        return awaitable { *this };
+    }
+
+    std::size_t run()
+    {
+        auto queue = std::exchange(queue_, {});
+        for (auto handle : queue) {
+            handle.resume();
+        }
+        return queue.size();
+    }
+
+private:
+    std::vector<std::coroutine_handle<>> queue_;
+};
+}
+
+lazy<> record(std::vector<int>& values, int value)
+{
+    values.push_back(value);
+    co_return;
+}
+
+lazy<> wait_and_record(manual_event& event, std::vector<int>& values, int value)
+{
+    co_await event;
+    values.push_back(value);
+}
+
+lazy<> increment(std::atomic<int>& counter)
+{
+    counter.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+detached join_and_set(async_scope& scope, bool& joined)
+{
+    co_await scope.join();
+    joined = true;
+}
+
+lazy<> wait_and_throw(manual_event& event, int value)
+{
+    co_await event;
+    throw value;
+}
+
+detached join_and_catch(async_scope& scope, bool& joined, int& caught)
+{
+    try {
+        co_await scope.join();
+    } catch (int value) {
+        caught = value;
+    }
+    joined = true;
+}
+
+TEST_CASE("spawn runs inline")
+{
+    async_scope scope;
+    std::vector<int> values;
+    scope.spawn(record(values, 1));
+    scope.spawn(record(values, 2));
+    CHECK_EQ(values, std::vector<int> { 1, 2 });
+    CHECK_EQ(scope.size(), 0);
+
+    bool joined = false;
+    join_and_set(scope, joined);
+    CHECK(joined);
+}
+
+TEST_CASE("join waits for outstanding tasks")
+{
+    async_scope scope;
+    manual_event first;
+    manual_event second;
+    std::vector<int> values;
+    scope.spawn(wait_and_record(first, values, 1));
+    scope.spawn(wait_and_record(second, values, 2));
+    CHECK_EQ(scope.size(), 2);
+
+    bool joined = false;
+    join_and_set(scope, joined);
+    CHECK_FALSE(joined);
+    second.set();
+    CHECK_FALSE(joined);
+    first.set();
+    CHECK(joined);
+    CHECK_EQ(values, std::vector<int> { 2, 1 });
+
+    // the scope can be reused after joining.
+    joined = false;
+    scope.spawn(record(values, 3));
+    join_and_set(scope, joined);
+    CHECK(joined);
+}
+
+TEST_CASE("spawn on scheduler")
+{
+    manual_scheduler scheduler;
+    async_scope scope;
+    std::vector<int> values;
+    scope.spawn(scheduler, record(values, 1));
+    scope.spawn(scheduler, record(values, 2));
+    CHECK(values.empty());
+
+    bool joined = false;
+    join_and_set(scope, joined);
+    CHECK_FALSE(joined);
+    CHECK_EQ(scheduler.run(), 2);
+    CHECK_EQ(values, std::vector<int> { 1, 2 });
+    CHECK(joined);
+}
+
+TEST_CASE("spawn from multiple threads")
+{
+    async_scope scope;
+    std::atomic<int> counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                scope.spawn(increment(counter));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    bool joined = false;
+    join_and_set(scope, joined);
+    CHECK(joined);
+    CHECK_EQ(counter, 4000);
+}
+
+TEST_CASE("join rethrows the first exception")
+{
+    async_scope scope;
+    manual_event first;
+    manual_event second;
+    manual_event third;
+    std::vector<int> values;
+    scope.spawn(wait_and_throw(first, 1));
+    scope.spawn(wait_and_record(second, values, 2));
+    scope.spawn(wait_and_throw(third, 3));
+
+    bool joined = false;
+    int caught = 0;
+    join_and_catch(scope, joined, caught);
+    first.set();
+    second.set();
+    CHECK_FALSE(joined);
+    third.set();
+    CHECK(joined);
+    CHECK_EQ(caught, 1);
+
+    // the exception is rethrown once.
+    joined = false;
+    caught = 0;
+    scope.spawn(record(values, 4));
+    join_and_catch(scope, joined, caught);
+    CHECK(joined);
+    CHECK_EQ(caught, 0);
+    CHECK_EQ(values, std::vector<int> { 2, 4 });
+}
+
+TEST_CASE("spawn fails to allocate")
+{
+    manual_scheduler scheduler;
+    async_scope scope;
+    std::vector<int> values;
+
+    // the tasks are allocated before the frames which drive them fail to.
+    auto first = record(values, 1);
+    CHECK_THROWS_AS(
+        [&]() {
+            fail_allocation = true;
+            scope.spawn(std::move(first));
+        }(),
+        std::bad_alloc);
+    auto second = record(values, 2);
+    CHECK_THROWS_AS(
+        [&]() {
+            fail_allocation = true;
+            scope.spawn(scheduler, std::move(second));
+        }(),
+        std::bad_alloc);
+    CHECK_EQ(scope.size(), 0);
+
+    bool joined = false;
+    join_and_set(scope, joined);
+    CHECK(joined);
+    CHECK_EQ(scheduler.run(), 0);
+    CHECK(values.empty());
+}
+
+TEST_SUITE_END();
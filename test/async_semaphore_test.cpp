@@ -0,0 +1,118 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_semaphore.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("async_semaphore");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached acquire_and_record(async_semaphore& semaphore,
+                            std::vector<int>& order,
+                            int id)
+{
+    co_await semaphore.acquire();
+    order.push_back(id);
+}
+
+detached limited(async_semaphore& semaphore,
+                 std::atomic<int>& active,
+                 std::atomic<int>& peak,
+                 std::atomic<int>& done)
+{
+    co_await semaphore.acquire();
+    auto current = active.fetch_add(1) + 1;
+    auto previous = peak.load();
+    while (previous < current && !peak.compare_exchange_weak(previous, current))
+        ;
+    active.fetch_sub(1);
+    semaphore.release();
+    done.fetch_add(1);
+}
+
+TEST_CASE("try_acquire")
+{
+    async_semaphore semaphore(2);
+    CHECK_EQ(semaphore.available(), 2);
+    CHECK(semaphore.try_acquire());
+    CHECK(semaphore.try_acquire());
+    CHECK_FALSE(semaphore.try_acquire());
+    semaphore.release(2);
+    CHECK_EQ(semaphore.available(), 2);
+}
+
+TEST_CASE("release resumes waiters in order")
+{
+    async_semaphore semaphore(1);
+    std::vector<int> order;
+    acquire_and_record(semaphore, order, 0);
+    acquire_and_record(semaphore, order, 1);
+    acquire_and_record(semaphore, order, 2);
+    acquire_and_record(semaphore, order, 3);
+    CHECK_EQ(order, std::vector<int> { 0 });
+    CHECK_EQ(semaphore.available(), 0);
+
+    semaphore.release(2);
+    CHECK_EQ(order, std::vector<int> { 0, 1, 2 });
+    semaphore.release(3);
+    CHECK_EQ(order, std::vector<int> { 0, 1, 2, 3 });
+    CHECK_EQ(semaphore.available(), 2);
+}
+
+TEST_CASE("multiple threads")
+{
+    async_semaphore semaphore(2);
+    std::atomic<int> active = 0;
+    std::atomic<int> peak = 0;
+    std::atomic<int> done = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                limited(semaphore, active, peak, done);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK_EQ(done, 4000);
+    CHECK_LE(peak, 2);
+    CHECK_EQ(semaphore.available(), 2);
+}
+
+TEST_SUITE_END();
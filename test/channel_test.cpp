@@ -0,0 +1,241 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/channel.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("channel");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached send_all(channel<int>& ch, int first, int last, bool close)
+{
+    for (int i = first; i < last; ++i) {
+        CHECK(co_await ch.send(i));
+    }
+    if (close) {
+        ch.close();
+    }
+}
+
+detached receive_all(channel<int>& ch, std::vector<int>& values)
+{
+    while (auto value = co_await ch.receive()) {
+        values.push_back(*value);
+    }
+}
+
+detached receive_sum(channel<int>& ch, std::atomic<long long>& sum)
+{
+    while (auto value = co_await ch.receive()) {
+        sum.fetch_add(*value, std::memory_order_relaxed);
+    }
+}
+
+TEST_CASE("try_send and try_receive")
+{
+    channel<int> ch(3);
+    CHECK_EQ(ch.capacity(), 4);
+    CHECK_FALSE(ch.try_receive());
+    for (int i = 0; i < 4; ++i) {
+        CHECK(ch.try_send(i));
+    }
+    CHECK_FALSE(ch.try_send(4));
+    for (int i = 0; i < 4; ++i) {
+        CHECK_EQ(ch.try_receive(), i);
+    }
+    CHECK_FALSE(ch.try_receive());
+}
+
+TEST_CASE("batch")
+{
+    channel<int> ch(8);
+    std::vector<int> input { 0, 1, 2, 3, 4, 5 };
+    CHECK_EQ(ch.try_send_n(input.begin(), input.size()), 6);
+    CHECK_EQ(ch.try_send_n(input.begin(), input.size()), 2);
+
+    std::vector<int> output;
+    CHECK_EQ(ch.try_receive_n(std::back_inserter(output), 5), 5);
+    CHECK_EQ(output, std::vector<int> { 0, 1, 2, 3, 4 });
+    CHECK_EQ(ch.try_receive_n(std::back_inserter(output), 5), 3);
+    CHECK_EQ(output, std::vector<int> { 0, 1, 2, 3, 4, 5, 0, 1 });
+    CHECK_EQ(ch.try_receive_n(std::back_inserter(output), 5), 0);
+}
+
+namespace {
+// throws when the `limit`th element is written.
+class throwing_output {
+public:
+    using difference_type = std::ptrdiff_t;
+
+    throwing_output(std::vector<int>& values, std::size_t limit)
+        : values_(&values)
+        , limit_(limit)
+    {
+    }
+
+    throwing_output& operator*()
+    {
+        return *this;
+    }
+
+    throwing_output& operator=(int value)
+    {
+        if (values_->size() + 1 == limit_) {
+            throw std::runtime_error("full");
+        }
+        values_->push_back(value);
+        return *this;
+    }
+
+    throwing_output& operator++()
+    {
+        return *this;
+    }
+
+    throwing_output operator++(int)
+    {
+        return *this;
+    }
+
+private:
+    std::vector<int>* values_;
+    std::size_t limit_;
+};
+}
+
+TEST_CASE("batch throwing")
+{
+    channel<int> ch(4);
+    std::vector<int> input { 0, 1, 2, 3 };
+    CHECK_EQ(ch.try_send_n(input.begin(), input.size()), 4);
+
+    std::vector<int> output;
+    CHECK_THROWS_AS(ch.try_receive_n(throwing_output(output, 2), 3),
+                    std::runtime_error);
+    CHECK_EQ(output, std::vector<int> { 0 });
+
+    // the claimed cells have been released, the element which was not
+    // claimed is still in the channel.
+    CHECK_EQ(ch.try_receive(), 3);
+    CHECK_EQ(ch.try_send_n(input.begin(), input.size()), 4);
+    CHECK_EQ(ch.try_receive_n(std::back_inserter(output), 4), 4);
+    CHECK_EQ(output, std::vector<int> { 0, 0, 1, 2, 3 });
+}
+
+TEST_CASE("move only")
+{
+    channel<std::unique_ptr<int>> ch(2);
+    CHECK(ch.try_send(std::make_unique<int>(1)));
+    CHECK(ch.try_send(std::make_unique<int>(2)));
+    auto first = ch.try_receive();
+    CHECK_EQ(**first, 1);
+    // the remaining element is destroyed with the channel.
+}
+
+TEST_CASE("backpressure")
+{
+    channel<int> ch(2);
+    std::vector<int> values;
+    send_all(ch, 0, 10, true);
+    CHECK_EQ(ch.try_receive(), 0);
+    receive_all(ch, values);
+    CHECK_EQ(values, std::vector<int> { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+}
+
+TEST_CASE("receivers wait for senders")
+{
+    channel<int> ch(2);
+    std::vector<int> values;
+    receive_all(ch, values);
+    receive_all(ch, values);
+    CHECK(values.empty());
+    send_all(ch, 0, 5, false);
+    CHECK_EQ(values, std::vector<int> { 0, 1, 2, 3, 4 });
+    ch.close();
+    CHECK_FALSE(ch.try_send(5));
+}
+
+TEST_CASE("close drains")
+{
+    channel<int> ch(4);
+    CHECK(ch.try_send(1));
+    CHECK(ch.try_send(2));
+    ch.close();
+    CHECK(ch.closed());
+    std::vector<int> values;
+    receive_all(ch, values);
+    CHECK_EQ(values, std::vector<int> { 1, 2 });
+}
+
+TEST_CASE("multiple producers and consumers")
+{
+    channel<int> ch(64);
+    std::atomic<long long> sum = 0;
+    constexpr int producers = 4;
+    constexpr int count = 20000;
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 2; ++i) {
+        consumers.emplace_back([&]() { receive_sum(ch, sum); });
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < producers; ++i) {
+        threads.emplace_back([&, i]() {
+            send_all(ch, i * count, (i + 1) * count, false);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& thread : consumers) {
+        thread.join();
+    }
+
+    // suspended coroutines are resumed inline by their counterparts, so
+    // all elements have been sent once the threads have been joined.
+    while (auto value = ch.try_receive()) {
+        sum.fetch_add(*value, std::memory_order_relaxed);
+    }
+    ch.close();
+
+    long long total = producers * count;
+    CHECK_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,175 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/coroutine_frame_pool.hpp>
+#include <iris/generator.hpp>
+#include <iris/lazy.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("coroutine_frame_pool");
+
+TEST_CASE("reuse released blocks")
+{
+    coroutine_frame_pool<> pool;
+    auto p1 = pool.allocate(100);
+    pool.deallocate(p1, 100);
+    auto p2 = pool.allocate(90);
+    CHECK_EQ(p1, p2);
+    auto p3 = pool.allocate(100);
+    CHECK_NE(p2, p3);
+    pool.deallocate(p2, 90);
+    pool.deallocate(p3, 100);
+
+    auto large = pool.allocate(1 << 20);
+    pool.deallocate(large, 1 << 20);
+}
+
+TEST_CASE("release on another thread")
+{
+    coroutine_frame_pool<int> pool;
+    std::vector<int*> blocks;
+    for (int i = 0; i < 100; ++i) {
+        blocks.push_back(pool.allocate(16));
+        *blocks.back() = i;
+    }
+
+    std::thread([&] {
+        for (auto block : blocks) {
+            pool.deallocate(block, 16);
+        }
+    }).join();
+
+    // the blocks returned by the other thread are reused.
+    auto block = pool.allocate(16);
+    CHECK_NE(std::find(blocks.begin(), blocks.end(), block), blocks.end());
+    pool.deallocate(block, 16);
+}
+
+TEST_CASE("release after the allocating thread exits")
+{
+    std::vector<std::byte*> blocks;
+    std::thread([&] {
+        coroutine_frame_pool<> pool;
+        for (int i = 0; i < 10; ++i) {
+            blocks.push_back(pool.allocate(128));
+        }
+        pool.deallocate(blocks.back(), 128);
+        blocks.pop_back();
+    }).join();
+
+    coroutine_frame_pool<> pool;
+    for (auto block : blocks) {
+        pool.deallocate(block, 128);
+    }
+}
+
+generator<const int&, int, coroutine_frame_pool<>> iota(int first, int last)
+{
+    for (int i = first; i < last; ++i) {
+        co_yield i;
+    }
+}
+
+generator<const int&, int, coroutine_frame_pool<>> nested_iota(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        co_yield ranges::elements_of(iota(i * 10, i * 10 + 10));
+    }
+}
+
+TEST_CASE("generator")
+{
+    CHECK(std::ranges::equal(nested_iota(10), std::views::iota(0, 100)));
+}
+
+template <typename T>
+class counting_allocator {
+public:
+    using value_type = T;
+
+    explicit counting_allocator(int& count) noexcept
+        : count_(&count)
+    {
+    }
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+        : count_(other.count_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++*count_;
+        return static_cast<T*>(std::malloc(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        --*count_;
+        std::free(p);
+    }
+
+    friend bool operator==(const counting_allocator&,
+                           const counting_allocator&)
+        = default;
+
+    int* count_;
+};
+
+// gcc 12 mistakes the frames which the promise allocates with its
+// `operator new` taking the allocator, and frees with its usual `operator
+// delete`, for mismatched allocations.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+lazy<int> add(std::allocator_arg_t, coroutine_frame_pool<>, int lhs, int rhs)
+{
+    co_return lhs + rhs;
+}
+
+lazy<int> add_counted(std::allocator_arg_t,
+                      counting_allocator<int> alloc,
+                      int lhs,
+                      int rhs,
+                      int& count)
+{
+    CHECK_EQ(count, 1);
+    co_return co_await add(std::allocator_arg, {}, lhs, rhs)
+        + *alloc.count_;
+}
+
+struct calculator {
+    int base;
+
+    lazy<int> add(std::allocator_arg_t, coroutine_frame_pool<>, int value)
+    {
+        co_return base + value;
+    }
+};
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+TEST_CASE("lazy with allocator")
+{
+    CHECK_EQ(add(std::allocator_arg, {}, 1, 2).sync_wait(), 3);
+
+    int count = 0;
+    CHECK_EQ(add_counted(std::allocator_arg, counting_allocator<int>(count), 1,
+                         2, count)
+                 .sync_wait(),
+             4);
+    CHECK_EQ(count, 0);
+
+    calculator calc { 10 };
+    CHECK_EQ(calc.add(std::allocator_arg, {}, 5).sync_wait(), 15);
+}
+
+TEST_SUITE_END();
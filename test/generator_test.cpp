@@ -2,6 +2,11 @@
 
 #include <iris/generator.hpp>
 
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 using namespace iris;
 
 TEST_SUITE_BEGIN("generator");
@@ -111,6 +116,96 @@ TEST_CASE("co_yield elements_of(range)")
     CHECK_EQ(count, 10);
 }
 
+generator<const int&> elements_of_span(std::span<const int> values,
+                                       int& resumed)
+{
+    co_yield ranges::elements_of(values);
+    ++resumed;
+    co_yield ranges::elements_of(std::span<const int>());
+    ++resumed;
+    co_yield -1;
+}
+
+TEST_CASE("co_yield elements_of(contiguous range)")
+{
+    const std::vector<int> values { 0, 1, 2, 3, 4 };
+    int resumed = 0;
+    auto g = elements_of_span(values, resumed);
+    auto it = g.begin();
+    for (int i = 0; i < 5; ++i) {
+        CHECK_EQ(*it, i);
+        CHECK_EQ(&*it, &values[i]);
+        CHECK_EQ(resumed, 0);
+        ++it;
+    }
+    CHECK_EQ(resumed, 2);
+    CHECK_EQ(*it, -1);
+    ++it;
+    CHECK(it == g.end());
+}
+
+generator<std::string> elements_of_strings(std::span<const std::string> values)
+{
+    co_yield ranges::elements_of(values);
+}
+
+TEST_CASE("co_yield elements_of(contiguous range) for generator<T>")
+{
+    const std::string values[] { "a", "b", "c" };
+    std::vector<std::string> result;
+    for (auto&& value : elements_of_strings(values)) {
+        result.push_back(std::move(value));
+    }
+    CHECK_EQ(result, std::vector<std::string> { "a", "b", "c" });
+    CHECK_EQ(values[0], "a");
+}
+
+generator<const int&> nested_elements_of_span(std::span<const int> values)
+{
+    co_yield 0;
+    co_yield ranges::elements_of(elements_of_range(1, 3));
+    co_yield ranges::elements_of(values);
+    co_yield 6;
+}
+
+generator<const int&> nested_nested_elements_of_span()
+{
+    const int values[] { 3, 4, 5 };
+    co_yield ranges::elements_of(nested_elements_of_span(values));
+}
+
+TEST_CASE("co_yield elements_of(contiguous range) in nested generator")
+{
+    CHECK(std::ranges::equal(nested_nested_elements_of_span(),
+                             std::views::iota(0, 7)));
+}
+
+generator<const int&> chain(int depth)
+{
+    if (depth == 0) {
+        co_yield 0;
+        co_yield 1;
+        throw std::runtime_error("leaf");
+    }
+    co_yield ranges::elements_of(chain(depth - 1));
+}
+
+TEST_CASE("co_yield elements_of(generator) nested 10000 levels deep")
+{
+    // resumption and completion use symmetric transfer, which keeps the
+    // stack flat only where the compiler emits tail calls, and destroying
+    // the chain recurses once per level. the depth has to stay within what
+    // an unoptimized build with a small stack can handle.
+    std::vector<int> values;
+    auto run = [&]() {
+        for (auto&& value : chain(10000)) {
+            values.push_back(value);
+        }
+    };
+    CHECK_THROWS_AS(run(), std::runtime_error);
+    CHECK_EQ(values, std::vector { 0, 1 });
+}
+
 generator<const int&> deeply_nested()
 {
     auto n1 = nested(0, 10);
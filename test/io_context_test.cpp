@@ -0,0 +1,329 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/io_context.hpp>
+
+#if defined(__linux__)
+
+#include <iris/lazy.hpp>
+
+#include <string_view>
+#include <thread>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("io_context");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+std::span<const std::byte> as_bytes(std::string_view str)
+{
+    return std::as_bytes(std::span(str.data(), str.size()));
+}
+
+std::string_view as_string(std::span<const std::byte> bytes)
+{
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()),
+                            bytes.size());
+}
+}
+
+lazy<std::size_t> write_all(socket& s, std::span<const std::byte> buffer)
+{
+    std::size_t total = 0;
+    while (total < buffer.size()) {
+        auto n = co_await s.async_write(buffer.subspan(total));
+        if (!n) {
+            break;
+        }
+        total += *n;
+    }
+    co_return total;
+}
+
+lazy<std::size_t> read_exactly(socket& s, std::span<std::byte> buffer)
+{
+    std::size_t total = 0;
+    while (total < buffer.size()) {
+        auto n = co_await s.async_read(buffer.subspan(total));
+        if (!n || *n == 0) {
+            break;
+        }
+        total += *n;
+    }
+    co_return total;
+}
+
+detached echo(socket& s, std::size_t size)
+{
+    std::vector<std::byte> buffer(size);
+    auto n = co_await read_exactly(s, buffer);
+    co_await write_all(s, std::span(buffer).first(n));
+}
+
+detached request(io_context& context,
+                 socket& s,
+                 std::string_view message,
+                 std::string& reply)
+{
+    co_await context.schedule();
+    auto n = co_await write_all(s, as_bytes(message));
+    CHECK_EQ(n, message.size());
+
+    std::vector<std::byte> buffer(message.size());
+    auto m = co_await read_exactly(s, buffer);
+    reply = as_string(std::span(buffer).first(m));
+    context.stop();
+}
+
+detached schedule_and_stop(io_context& context, std::thread::id& id)
+{
+    co_await context.schedule();
+    id = std::this_thread::get_id();
+    context.stop();
+}
+
+TEST_CASE("schedule")
+{
+    io_context context;
+    std::thread::id id;
+    schedule_and_stop(context, id);
+    CHECK_EQ(id, std::thread::id());
+    context.run();
+    CHECK_EQ(id, std::this_thread::get_id());
+}
+
+detached sleep_and_record(io_context& context,
+                          std::chrono::milliseconds duration,
+                          std::vector<int>& order,
+                          int id)
+{
+    co_await context.sleep_for(duration);
+    CHECK(context.running_in_this_thread());
+    order.push_back(id);
+    if (order.size() == 3) {
+        context.stop();
+    }
+}
+
+TEST_CASE("post from another thread")
+{
+    io_context context;
+    std::thread::id id;
+    std::thread thread([&]() { schedule_and_stop(context, id); });
+    context.run();
+    thread.join();
+    CHECK_EQ(id, std::this_thread::get_id());
+}
+
+TEST_CASE("run_for")
+{
+    io_context context;
+    auto start = std::chrono::steady_clock::now();
+    context.run_for(std::chrono::milliseconds(20));
+    CHECK(std::chrono::steady_clock::now() - start
+          >= std::chrono::milliseconds(20));
+    CHECK(!context.stopped());
+}
+
+TEST_CASE("sleep_for")
+{
+    io_context context;
+    std::vector<int> order;
+    auto start = std::chrono::steady_clock::now();
+    sleep_and_record(context, std::chrono::milliseconds(30), order, 2);
+    sleep_and_record(context, std::chrono::milliseconds(10), order, 0);
+    sleep_and_record(context, std::chrono::milliseconds(20), order, 1);
+    CHECK(!context.running_in_this_thread());
+    context.run();
+    CHECK(std::chrono::steady_clock::now() - start
+          >= std::chrono::milliseconds(30));
+    CHECK_EQ(order, std::vector<int> { 0, 1, 2 });
+}
+
+TEST_CASE("socketpair")
+{
+    io_context context;
+    auto pair = socket::open_pair(context);
+    REQUIRE(pair);
+    auto& [client, server] = *pair;
+
+    std::string reply;
+    std::string_view message = "hello iris";
+    echo(server, message.size());
+    request(context, client, message, reply);
+    context.run();
+    CHECK_EQ(reply, message);
+}
+
+TEST_CASE("socketpair large transfer")
+{
+    io_context context;
+    auto pair = socket::open_pair(context);
+    REQUIRE(pair);
+    auto& [client, server] = *pair;
+
+    std::string message(4 * 1024 * 1024, 'x');
+    std::string reply;
+    echo(server, message.size());
+    request(context, client, message, reply);
+    context.run();
+    CHECK_EQ(reply.size(), message.size());
+    CHECK_EQ(reply, message);
+}
+
+detached accept_and_echo(acceptor& listener,
+                         std::optional<socket>& server,
+                         std::size_t size)
+{
+    auto accepted = co_await listener.async_accept();
+    REQUIRE(accepted);
+    server.emplace(std::move(*accepted));
+    echo(*server, size);
+}
+
+detached connect_and_request(io_context& context,
+                             socket& client,
+                             ipv4_endpoint endpoint,
+                             std::string_view message,
+                             std::string& reply)
+{
+    auto connected = co_await client.async_connect(endpoint);
+    REQUIRE(connected);
+    request(context, client, message, reply);
+}
+
+TEST_CASE("loopback")
+{
+    io_context context;
+    acceptor listener(context);
+    REQUIRE(listener.listen(ipv4_endpoint::loopback()));
+    auto endpoint = listener.local_endpoint();
+    REQUIRE(endpoint);
+    CHECK_NE(endpoint->port(), 0);
+
+    std::optional<socket> server;
+    std::string reply;
+    std::string_view message = "hello loopback";
+    accept_and_echo(listener, server, message.size());
+
+    auto client = socket::open(context);
+    REQUIRE(client);
+    connect_and_request(context, *client, *endpoint, message, reply);
+
+    context.run();
+    CHECK_EQ(reply, message);
+}
+
+detached connect_and_stop(io_context& context,
+                          socket& client,
+                          ipv4_endpoint endpoint,
+                          std::error_code& ec)
+{
+    auto connected = co_await client.async_connect(endpoint);
+    ec = connected ? std::error_code() : connected.error();
+    context.stop();
+}
+
+TEST_CASE("connection refused")
+{
+    io_context context;
+    acceptor listener(context);
+    REQUIRE(listener.listen(ipv4_endpoint::loopback()));
+    auto endpoint = *listener.local_endpoint();
+    listener.close();
+
+    auto client = socket::open(context);
+    REQUIRE(client);
+    std::error_code ec;
+    connect_and_stop(context, *client, endpoint, ec);
+    context.run();
+    CHECK_EQ(ec, std::errc::connection_refused);
+}
+
+detached read_and_stop(io_context& context, socket& s, std::error_code& ec)
+{
+    std::byte buffer[16];
+    auto n = co_await s.async_read(buffer);
+    ec = n ? std::error_code() : n.error();
+    context.stop();
+}
+
+detached close_later(io_context& context, socket& s)
+{
+    co_await context.schedule();
+    s.close();
+}
+
+TEST_CASE("close cancels a pending read")
+{
+    io_context context;
+    auto pair = socket::open_pair(context);
+    REQUIRE(pair);
+    auto& [client, server] = *pair;
+
+    std::error_code ec;
+    read_and_stop(context, server, ec);
+    close_later(context, server);
+    context.run();
+    CHECK_FALSE(server.is_open());
+    CHECK_EQ(ec, std::errc::operation_canceled);
+}
+
+detached accept_and_stop(io_context& context,
+                         acceptor& listener,
+                         std::error_code& ec)
+{
+    auto accepted = co_await listener.async_accept();
+    ec = accepted ? std::error_code() : accepted.error();
+    context.stop();
+}
+
+detached close_later(io_context& context, acceptor& listener)
+{
+    co_await context.schedule();
+    listener.close();
+}
+
+TEST_CASE("close cancels a pending accept")
+{
+    io_context context;
+    acceptor listener(context);
+    REQUIRE(listener.listen(ipv4_endpoint::loopback()));
+
+    std::error_code ec;
+    accept_and_stop(context, listener, ec);
+    close_later(context, listener);
+    context.run();
+    CHECK_EQ(ec, std::errc::operation_canceled);
+}
+
+TEST_SUITE_END();
+
+#endif
@@ -1,6 +1,11 @@
 #include <thirdparty/test.hpp>
 
 #include <iris/lazy.hpp>
+#include <iris/scope.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 using namespace iris;
 
@@ -56,4 +61,175 @@ TEST_CASE("nested lazy<int>")
     CHECK_EQ(result, 1300);
 }
 
+lazy<int> throw_runtime_error()
+{
+    throw std::runtime_error("lazy");
+    co_return 0;
+}
+
+lazy<int> rethrow_nested(int& reached)
+{
+    auto value = co_await throw_runtime_error();
+    reached = value;
+    co_return value;
+}
+
+TEST_CASE("exception propagation")
+{
+    int reached = 0;
+    CHECK_THROWS_AS(rethrow_nested(reached).sync_wait(), std::runtime_error);
+    CHECK_EQ(reached, 0);
+}
+
+lazy<> throw_void()
+{
+    throw std::logic_error("lazy");
+    co_return;
+}
+
+lazy<bool> catch_nested()
+{
+    try {
+        co_await throw_void();
+    } catch (const std::logic_error&) {
+        co_return true;
+    }
+    co_return false;
+}
+
+TEST_CASE("exception caught by awaiter")
+{
+    CHECK(catch_nested().sync_wait());
+}
+
+struct non_default_constructible {
+    explicit non_default_constructible(int value)
+        : value_(value)
+    {
+    }
+
+    int value_;
+};
+
+lazy<non_default_constructible> make_non_default_constructible()
+{
+    co_return non_default_constructible(7);
+}
+
+TEST_CASE("non default constructible result")
+{
+    CHECK_EQ(make_non_default_constructible().sync_wait().value_, 7);
+}
+
+expected<int, std::string> parse(int value)
+{
+    if (value < 0) {
+        return unexpected(std::string("negative"));
+    }
+    return value;
+}
+
+expected<void, std::string> validate(int value)
+{
+    if (value > 100) {
+        return unexpected(std::string("too large"));
+    }
+    return {};
+}
+
+lazy<expected<int, std::string>> sum(int lhs, int rhs, int& steps)
+{
+    auto left = co_await parse(lhs);
+    ++steps;
+    auto right = parse(rhs);
+    int right_value = co_await right;
+    ++steps;
+    co_await validate(left + right_value);
+    ++steps;
+    co_return left + right_value;
+}
+
+lazy<expected<std::unique_ptr<int>, std::string>> make_unique(int value)
+{
+    auto ptr = co_await expected<std::unique_ptr<int>, std::string>(
+        std::make_unique<int>(co_await parse(value)));
+    co_return std::move(ptr);
+}
+
+lazy<expected<int, std::string>> nested_sum(int lhs, int rhs, int& steps)
+{
+    auto value = co_await co_await sum(lhs, rhs, steps);
+    co_return value * 2;
+}
+
+TEST_CASE("lazy<expected<T, E>> early exit")
+{
+    int steps = 0;
+    CHECK_EQ(sum(1, 2, steps).sync_wait(), 3);
+    CHECK_EQ(steps, 3);
+
+    steps = 0;
+    CHECK_EQ(sum(-1, 2, steps).sync_wait(),
+             unexpected(std::string("negative")));
+    CHECK_EQ(steps, 0);
+
+    steps = 0;
+    CHECK_EQ(sum(1, -2, steps).sync_wait(),
+             unexpected(std::string("negative")));
+    CHECK_EQ(steps, 1);
+
+    steps = 0;
+    CHECK_EQ(sum(100, 2, steps).sync_wait(),
+             unexpected(std::string("too large")));
+    CHECK_EQ(steps, 2);
+
+    steps = 0;
+    CHECK_EQ(nested_sum(1, 2, steps).sync_wait(), 6);
+    CHECK_EQ(nested_sum(-1, 2, steps).sync_wait(),
+             unexpected(std::string("negative")));
+
+    CHECK_EQ(**make_unique(5).sync_wait(), 5);
+    CHECK_EQ(make_unique(-5).sync_wait().error(), "negative");
+}
+
+lazy<expected<int, std::string>> parse_guarded(int value, bool& destroyed)
+{
+    scope_exit guard([&destroyed]() noexcept { destroyed = true; });
+    co_return co_await parse(value);
+}
+
+TEST_CASE("lazy<expected<T, E>> early exit keeps the locals until destroyed")
+{
+    bool destroyed = false;
+    {
+        auto task = parse_guarded(-1, destroyed);
+        CHECK_EQ(task.sync_wait(), unexpected(std::string("negative")));
+        CHECK_FALSE(destroyed);
+    }
+    CHECK(destroyed);
+}
+
+// gcc 12 mistakes the frames which the promise allocates with its
+// `operator new` taking the allocator, and frees with its usual `operator
+// delete`, for mismatched allocations.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+lazy<expected<int, std::string>>
+parse_allocated(std::allocator_arg_t, std::allocator<int>, int value)
+{
+    co_return co_await parse(value) + 1;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+TEST_CASE("lazy<expected<T, E>> early exit with an allocator")
+{
+    CHECK_EQ(parse_allocated(std::allocator_arg, {}, 1).sync_wait(), 2);
+    CHECK_EQ(parse_allocated(std::allocator_arg, {}, -1).sync_wait(),
+             unexpected(std::string("negative")));
+}
+
 TEST_SUITE_END();
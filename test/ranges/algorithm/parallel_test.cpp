@@ -0,0 +1,119 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/algorithm/parallel.hpp>
+#include <iris/ranges/view/cartesian_product_view.hpp>
+#include <iris/run_loop.hpp>
+#include <iris/thread_pool.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("parallel");
+
+TEST_CASE("for_each")
+{
+    thread_pool pool(4);
+    std::vector<int> values(100000);
+    ranges::par::for_each(pool, values, [](int& value) { value += 1; });
+    CHECK(std::ranges::all_of(values, [](int value) { return value == 1; }));
+
+    std::atomic<int> count = 0;
+    ranges::par::for_each(pool, std::views::iota(0, 0),
+                          [&](int) { ++count; });
+    CHECK_EQ(count, 0);
+
+    std::vector<int> lhs(1000, 1);
+    std::vector<int> rhs(1000, 2);
+    ranges::par::for_each(pool, std::views::iota(0, 1000),
+                          [&](int i) { lhs[i] += rhs[i]; });
+    CHECK(std::ranges::all_of(lhs, [](int value) { return value == 3; }));
+}
+
+TEST_CASE("for_each throws")
+{
+    thread_pool pool(4);
+    std::atomic<int> count = 0;
+    CHECK_THROWS_AS(ranges::par::for_each(pool, std::views::iota(0, 100000),
+                                          [&](int value) {
+                                              ++count;
+                                              if (value == 5000) {
+                                                  throw std::runtime_error(
+                                                      "parallel");
+                                              }
+                                          }),
+                    std::runtime_error);
+    CHECK_GT(count, 0);
+}
+
+TEST_CASE("transform")
+{
+    thread_pool pool(3);
+    std::vector<long> squares(12345);
+    auto end = ranges::par::transform(pool, std::views::iota(0, 12345),
+                                      squares.begin(), [](int value) {
+                                          return long(value) * value;
+                                      });
+    CHECK(end == squares.end());
+    CHECK(std::ranges::equal(
+        squares, std::views::iota(0, 12345) | std::views::transform([](int i) {
+                     return long(i) * i;
+                 })));
+}
+
+TEST_CASE("reduce")
+{
+    thread_pool pool(4);
+    CHECK_EQ(ranges::par::reduce(pool, std::views::iota(1, 100001), 0L),
+             5000050000L);
+    CHECK_EQ(ranges::par::reduce(pool, std::views::iota(0, 0), 42), 42);
+
+    // the elements are combined in order.
+    std::vector<std::string> words(5000, "a");
+    words.back() = "b";
+    auto joined = ranges::par::reduce(pool, words, std::string("^"));
+    CHECK_EQ(joined.size(), 5001);
+    CHECK_EQ(joined.front(), '^');
+    CHECK_EQ(joined.back(), 'b');
+
+    // the product of [0, 200) x [0, 300) summed up.
+    auto product = views::cartesian_product(std::views::iota(0, 200),
+                                            std::views::iota(0, 300));
+    CHECK_EQ(ranges::par::fold(
+                 pool, product, 0L,
+                 [](long sum, auto pair) {
+                     auto [x, y] = pair;
+                     return sum + x * y;
+                 },
+                 std::plus<> {}),
+             long(199 * 200 / 2) * (299 * 300 / 2));
+}
+
+TEST_CASE("fold")
+{
+    thread_pool pool(2);
+    std::string text(100000, 'a');
+    for (std::size_t i = 0; i < text.size(); i += 7) {
+        text[i] = ' ';
+    }
+    auto spaces = ranges::par::fold(
+        pool, text, std::size_t(0),
+        [](std::size_t count, char c) { return count + (c == ' '); },
+        std::plus<> {});
+    CHECK_EQ(spaces, (text.size() + 6) / 7);
+}
+
+TEST_CASE("run_loop scheduler")
+{
+    // nobody runs the loop, so the calling thread does all the work.
+    run_loop loop;
+    CHECK_EQ(ranges::par::reduce(loop, std::views::iota(1, 1001), 0), 500500);
+    loop.finish();
+    loop.run();
+}
+
+TEST_SUITE_END();
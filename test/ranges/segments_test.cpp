@@ -0,0 +1,162 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/algorithm/contains.hpp>
+#include <iris/ranges/algorithm/find_last.hpp>
+#include <iris/ranges/algorithm/fold.hpp>
+#include <iris/ranges/segments.hpp>
+#include <iris/ranges/to.hpp>
+#include <iris/ranges/view/concat_view.hpp>
+#include <iris/ranges/view/join_with_view.hpp>
+
+#include <forward_list>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("ranges/segments");
+
+template <typename Range>
+std::vector<std::vector<int>> segments_of(Range&& range)
+{
+    std::vector<std::vector<int>> result;
+    ranges::segments(range, [&](auto& segment, auto position) {
+        result.emplace_back();
+        for (auto it = std::ranges::begin(segment);
+             it != std::ranges::end(segment); ++it) {
+            result.back().push_back(*it);
+            CHECK_EQ(*position(it), *it);
+        }
+        return true;
+    });
+    return result;
+}
+
+TEST_CASE("segmented_range")
+{
+    static_assert(!ranges::segmented_range<std::vector<int>&>);
+    static_assert(ranges::segmented_range<decltype(views::concat(
+                      std::declval<std::vector<int>&>(),
+                      std::declval<std::list<int>&>()))&>);
+    static_assert(ranges::segmented_range<decltype(views::join_with(
+                      std::declval<std::vector<std::vector<int>>&>(),
+                      std::declval<std::vector<int>&>()))&>);
+}
+
+TEST_CASE("not segmented")
+{
+    auto input = std::vector { 0, 1, 2 };
+    CHECK_EQ(segments_of(input), std::vector<std::vector<int>> { { 0, 1, 2 } });
+}
+
+TEST_CASE("concat_view")
+{
+    auto input0 = std::vector { 0, 1 };
+    auto input1 = std::list { 2, 3, 4 };
+    auto input2 = std::vector<int> {};
+    auto view = views::concat(input0, input1, input2, std::views::single(5));
+    const auto expected = std::vector<std::vector<int>> {
+        { 0, 1 }, { 2, 3, 4 }, {}, { 5 }
+    };
+    CHECK_EQ(segments_of(view), expected);
+    CHECK_EQ(segments_of(std::as_const(view)), expected);
+
+    // nested segmented ranges are flattened.
+    auto nested = views::concat(view, input0);
+    CHECK_EQ(segments_of(nested),
+             std::vector<std::vector<int>> {
+                 { 0, 1 }, { 2, 3, 4 }, {}, { 5 }, { 0, 1 } });
+}
+
+TEST_CASE("join_with_view")
+{
+    auto input = std::vector<std::vector<int>> { { 0, 1 }, {}, { 2 } };
+    auto pattern = std::vector { -1, -2 };
+    auto view = views::join_with(input, pattern);
+    CHECK_EQ(segments_of(view),
+             std::vector<std::vector<int>> {
+                 { 0, 1 }, { -1, -2 }, {}, { -1, -2 }, { 2 } });
+    CHECK_EQ(segments_of(std::as_const(view)),
+             std::vector<std::vector<int>> {
+                 { 0, 1 }, { -1, -2 }, {}, { -1, -2 }, { 2 } });
+}
+
+TEST_CASE("stop early")
+{
+    auto input0 = std::vector { 0, 1 };
+    auto input1 = std::vector { 2, 3 };
+    int visited = 0;
+    CHECK(!ranges::segments(views::concat(input0, input1),
+                            [&](auto&, auto) { return ++visited != 1; }));
+    CHECK_EQ(visited, 1);
+}
+
+TEST_CASE("algorithms")
+{
+    auto input0 = std::vector { 0, 1, 2 };
+    auto input1 = std::list { 3, 2 };
+    auto view = views::concat(input0, input1, std::views::iota(5, 7));
+
+    CHECK_EQ(ranges::fold_left(view, 0, std::plus {}), 19);
+    CHECK_EQ(ranges::fold_left(views::concat(input0, input1), 0, std::plus {}),
+             8);
+    CHECK_EQ(ranges::fold_left(views::concat(std::vector<int> {}, input1), 10,
+                               std::minus {}),
+             5);
+
+    CHECK(ranges::contains(view, 3));
+    CHECK(ranges::contains(view, 6));
+    CHECK(!ranges::contains(view, 7));
+
+    auto common = views::concat(input0, input1);
+    auto found = ranges::find_last(common, 2);
+    CHECK_EQ(found.begin(), std::ranges::next(common.begin(), 4));
+    CHECK_EQ(found.end(), common.end());
+    CHECK(std::ranges::equal(
+        ranges::find_last_if(common, [](int i) { return i < 2; }),
+        std::vector { 1, 2, 3, 2 }));
+    CHECK(std::ranges::equal(
+        ranges::find_last_if_not(common, [](int i) { return i > 1; }),
+        std::vector { 1, 2, 3, 2 }));
+    CHECK(ranges::find_last(common, 9).empty());
+
+    auto input2 = std::forward_list { 3, 2, 4 };
+    auto forward = views::concat(input0, input2);
+    static_assert(!std::ranges::bidirectional_range<decltype(forward)>);
+    CHECK(std::ranges::equal(ranges::find_last(forward, 2),
+                             std::vector { 2, 4 }));
+    CHECK(std::ranges::equal(
+        ranges::find_last_if(forward, [](int i) { return i < 2; }),
+        std::vector { 1, 2, 3, 2, 4 }));
+    CHECK(ranges::find_last_if_not(forward, [](int i) { return i < 9; })
+              .empty());
+
+    // a bidirectional range is still searched backward from its end.
+    auto zeros = std::vector<int>(1000, 0);
+    auto one = std::vector { 1 };
+    auto tail = views::concat(zeros, one);
+    int invocations = 0;
+    CHECK_EQ(ranges::find_last_if(tail,
+                                  [&](int i) {
+                                      ++invocations;
+                                      return i == 1;
+                                  })
+                 .size(),
+             1);
+    CHECK_EQ(invocations, 1);
+
+    CHECK_EQ(ranges::to<std::vector<int>>(view),
+             std::vector { 0, 1, 2, 3, 2, 5, 6 });
+    CHECK_EQ(ranges::to<std::vector>(view),
+             std::vector { 0, 1, 2, 3, 2, 5, 6 });
+
+    auto words = std::vector<std::string> { "ab", "", "c" };
+    auto joined = views::join_with(words, std::string_view(", "));
+    CHECK_EQ(ranges::to<std::string>(joined), "ab, , c");
+    CHECK(ranges::contains(joined, ' '));
+    CHECK_EQ(ranges::fold_left(joined, 0, [](int n, char) { return n + 1; }),
+             7);
+}
+
+TEST_SUITE_END();
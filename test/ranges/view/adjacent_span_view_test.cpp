@@ -0,0 +1,75 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/adjacent_span_view.hpp>
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("adjacent_span_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<int>;
+    static_assert(
+        std::same_as<decltype(views::adjacent_span<2>(
+                         std::declval<input_type&>())),
+                     ranges::adjacent_span_view<std::views::all_t<input_type&>,
+                                                2>>);
+    static_assert(std::same_as<
+                  decltype(std::declval<input_type&>()
+                           | views::adjacent_span<2>),
+                  ranges::adjacent_span_view<std::views::all_t<input_type&>,
+                                             2>>);
+}
+
+TEST_CASE("windows overlap")
+{
+    auto input = std::vector { 0, 1, 2, 3, 4 };
+    auto view = input | views::adjacent_span<3>;
+    using view_type = decltype(view);
+    static_assert(std::ranges::random_access_range<view_type>);
+    static_assert(std::ranges::sized_range<view_type>);
+    static_assert(std::ranges::common_range<view_type>);
+    static_assert(std::same_as<std::ranges::range_reference_t<view_type>,
+                               std::span<int, 3>>);
+    static_assert(sizeof(std::ranges::iterator_t<view_type>) == sizeof(int*));
+
+    // each window starts one element after the previous one.
+    CHECK_EQ(std::ranges::size(view), 3);
+    auto first = std::ranges::begin(view);
+    for (int i = 0; i < 3; ++i) {
+        CHECK_EQ(first[i].data(), input.data() + i);
+    }
+    CHECK_EQ(std::ranges::end(view) - first, 3);
+    CHECK(std::ranges::equal(*std::ranges::prev(std::ranges::end(view)),
+                             std::array { 2, 3, 4 }));
+
+    // a write through one window is seen by the windows which overlap it.
+    first[1][1] = -1;
+    CHECK(std::ranges::equal(first[0], std::array { 0, 1, -1 }));
+    CHECK(std::ranges::equal(first[2], std::array { -1, 3, 4 }));
+}
+
+TEST_CASE("moving average")
+{
+    static const auto input = std::array { 1, 2, 3, 4, 5, 6 };
+    auto sums = std::vector<int>();
+    for (auto window : input | views::adjacent_span<2>) {
+        sums.push_back(std::accumulate(window.begin(), window.end(), 0));
+    }
+    CHECK_EQ(sums, std::vector { 3, 5, 7, 9, 11 });
+}
+
+TEST_CASE("fewer elements than the window")
+{
+    static const auto input = std::array { 0, 1 };
+    CHECK(std::ranges::empty(input | views::adjacent_span<3>));
+    CHECK_EQ(std::ranges::size(input | views::adjacent_span<2>), 1);
+    CHECK(std::ranges::empty(std::span<const int>()
+                             | views::adjacent_span<1>));
+}
+
+TEST_SUITE_END();
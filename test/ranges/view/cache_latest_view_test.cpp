@@ -0,0 +1,106 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/as_rvalue_view.hpp>
+#include <iris/ranges/view/cache_latest_view.hpp>
+#include <iris/ranges/view/zip_transform_view.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("cache_latest_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<int>;
+    using view_type = ranges::cache_latest_view<std::views::all_t<input_type&>>;
+    static_assert(std::same_as<
+                  decltype(views::cache_latest(std::declval<input_type&>())),
+                  view_type>);
+    static_assert(std::same_as<decltype(std::declval<input_type&>()
+                                        | views::cache_latest),
+                               view_type>);
+    static_assert(std::ranges::input_range<view_type>);
+    static_assert(!std::ranges::forward_range<view_type>);
+    static_assert(std::ranges::sized_range<view_type>);
+    static_assert(
+        std::same_as<std::ranges::range_reference_t<view_type>, int&>);
+}
+
+TEST_CASE("transform then filter")
+{
+    const auto input = std::vector { 0, 1, 2, 3, 4, 5 };
+    int invocations = 0;
+    auto square = [&](int i) {
+        ++invocations;
+        return i * i;
+    };
+    auto even = [](int i) { return i % 2 == 0; };
+
+    auto uncached = input | std::views::transform(square)
+        | std::views::filter(even);
+    CHECK(std::ranges::equal(uncached, std::vector { 0, 4, 16 }));
+    CHECK_EQ(invocations, 9);
+
+    invocations = 0;
+    auto cached = input | std::views::transform(square) | views::cache_latest
+        | std::views::filter(even);
+    CHECK(std::ranges::equal(cached, std::vector { 0, 4, 16 }));
+    CHECK_EQ(invocations, 6);
+}
+
+TEST_CASE("zip_transform")
+{
+    auto input0 = std::vector { 1, 2, 3 };
+    auto input1 = std::vector { 4, 5, 6 };
+    int invocations = 0;
+    auto view = views::zip_transform(
+                    [&](int lhs, int rhs) {
+                        ++invocations;
+                        return std::vector { lhs, rhs };
+                    },
+                    input0, input1)
+        | views::cache_latest;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        CHECK_EQ((*it)[0] + 3, (*it)[1]);
+        CHECK_EQ((*it).size(), 2);
+    }
+    CHECK_EQ(invocations, 3);
+}
+
+TEST_CASE("lvalue references are not copied")
+{
+    auto input = std::vector { 0, 1, 2 };
+    auto view = input | views::cache_latest;
+    auto it = view.begin();
+    CHECK_EQ(&*it, input.data());
+    ++it;
+    *it = 10;
+    CHECK_EQ(input[1], 10);
+    ++it;
+    ++it;
+    CHECK(it == view.end());
+    CHECK_EQ(view.end() - view.begin(), 3);
+}
+
+TEST_CASE("rvalue references")
+{
+    auto input = std::vector<std::string> { "a", "b" };
+    auto view = input | views::as_rvalue | views::cache_latest;
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(view)>,
+                               std::string&>);
+    static_assert(
+        std::same_as<std::ranges::range_rvalue_reference_t<decltype(view)>,
+                     std::string&&>);
+
+    auto it = view.begin();
+    CHECK_EQ(&*it, &input[0]);
+    std::string moved = std::ranges::iter_move(it);
+    CHECK_EQ(moved, "a");
+    CHECK(input[0].empty());
+    ++it;
+    CHECK_EQ(&*it, &input[1]);
+}
+
+TEST_SUITE_END();
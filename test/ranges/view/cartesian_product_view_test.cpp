@@ -4,6 +4,7 @@
 
 #include <forward_list>
 #include <list>
+#include <vector>
 
 using namespace iris;
 
@@ -162,4 +163,72 @@ TEST_CASE("random_access_range")
     CHECK_EQ(curr, std::ranges::begin(view));
 }
 
+TEST_CASE("random access jumps")
+{
+    static const int input0[] = { 0, 1, 2 };
+    static const int input1[] = { 3, 4 };
+    static const int input2[] = { 5, 6, 7, 8 };
+    auto view = views::cartesian_product(input0, input1, input2);
+    const auto first = std::ranges::begin(view);
+    for (int i = 0; i <= 24; ++i) {
+        auto it = first + i;
+        CHECK_EQ(it, std::ranges::next(first, i));
+        CHECK_EQ(it - first, i);
+        for (int j = 0; j <= 24; ++j) {
+            CHECK_EQ(it + (j - i), first + j);
+        }
+    }
+    CHECK_EQ(first + 24, std::ranges::end(view));
+    CHECK_EQ(first[13], std::tuple { 1, 4, 6 });
+}
+
+template <typename View>
+concept partitionable = requires(View& view)
+{
+    view.partition(2);
+};
+
+TEST_CASE("partition")
+{
+    static const int input0[] = { 0, 1, 2 };
+    static const int input1[] = { 3, 4 };
+    static const int input2[] = { 5, 6, 7, 8 };
+    auto view = views::cartesian_product(input0, input1, input2);
+    static_assert(partitionable<decltype(view)>);
+    static_assert(partitionable<const decltype(view)>);
+    for (std::size_t n : { 1, 2, 5, 7, 24, 30 }) {
+        auto blocks = view.partition(n);
+        CHECK_EQ(blocks.size(), n);
+
+        std::vector<std::tuple<int, int, int>> joined;
+        for (auto block : blocks) {
+            const auto size = std::ranges::size(block);
+            CHECK((size == 24 / n || size == 24 / n + 1));
+            joined.insert(joined.end(), block.begin(), block.end());
+        }
+        CHECK(std::ranges::equal(joined, view));
+    }
+
+    CHECK(std::ranges::equal(std::as_const(view).partition(4)[1],
+                             std::vector<std::tuple<int, int, int>> {
+                                 { 0, 4, 7 },
+                                 { 0, 4, 8 },
+                                 { 1, 3, 5 },
+                                 { 1, 3, 6 },
+                                 { 1, 3, 7 },
+                                 { 1, 3, 8 },
+                             }));
+
+    auto empty = views::cartesian_product(input0, std::views::empty<int>);
+    for (auto block : empty.partition(3)) {
+        CHECK(block.empty());
+    }
+
+    // a product whose size is unknown cannot be partitioned.
+    auto unbounded = views::cartesian_product(std::views::iota(0), input1);
+    static_assert(std::ranges::random_access_range<decltype(unbounded)>);
+    static_assert(!partitionable<decltype(unbounded)>);
+    static_assert(!partitionable<const decltype(unbounded)>);
+}
+
 TEST_SUITE_END();
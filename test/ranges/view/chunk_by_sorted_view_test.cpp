@@ -0,0 +1,91 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/chunk_by_sorted_view.hpp>
+
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("chunk_by_sorted_view");
+
+TEST_CASE("random_access_range")
+{
+    static const auto input = std::vector { 0, 1, 1, 2, 2, 2, 2, 2, 3, 4, 4 };
+    auto view = input | views::chunk_by_sorted(std::ranges::equal_to {});
+    using view_type = decltype(view);
+    static_assert(std::same_as<
+                  typename std::ranges::iterator_t<view_type>::iterator_concept,
+                  std::forward_iterator_tag>);
+    static_assert(std::ranges::common_range<view_type>);
+    auto curr = std::ranges::begin(view);
+    CHECK(std::ranges::equal(*curr++, std::vector { 0 }));
+    CHECK(std::ranges::equal(*curr++, std::vector { 1, 1 }));
+    CHECK(std::ranges::equal(*curr++, std::vector { 2, 2, 2, 2, 2 }));
+    CHECK(std::ranges::equal(*curr++, std::vector { 3 }));
+    CHECK(std::ranges::equal(*curr++, std::vector { 4, 4 }));
+    CHECK_EQ(curr, std::ranges::end(view));
+
+    CHECK(std::ranges::empty(std::vector<int> {}
+                             | views::chunk_by_sorted(std::equal_to {})));
+}
+
+TEST_CASE("same chunks as chunk_by")
+{
+    for (int size = 0; size < 40; ++size) {
+        for (int width = 1; width < 12; ++width) {
+            std::vector<int> input;
+            for (int i = 0; i < size; ++i) {
+                input.push_back(i / width + i / 7);
+            }
+            std::vector<std::vector<int>> expected;
+            for (auto i = input.begin(); i != input.end();) {
+                auto j = std::find_if(i, input.end(),
+                                      [&](int v) { return v != *i; });
+                expected.emplace_back(i, j);
+                i = j;
+            }
+
+            std::vector<std::vector<int>> forward;
+            for (auto chunk :
+                 input | views::chunk_by_sorted(std::equal_to {})) {
+                forward.emplace_back(chunk.begin(), chunk.end());
+            }
+            CHECK_EQ(forward, expected);
+        }
+    }
+}
+
+TEST_CASE("chunks are defined by their first element")
+{
+    // not an equivalence relation, so a chunk depends on where it starts.
+    const auto input = std::vector { 0, 5, 9, 12, 20, 21, 30 };
+    auto view = input | views::chunk_by_sorted([](int first, int i) {
+                    return i - first < 10;
+                });
+    std::vector<std::vector<int>> chunks;
+    for (auto chunk : view) {
+        chunks.emplace_back(chunk.begin(), chunk.end());
+    }
+    CHECK_EQ(chunks,
+             std::vector<std::vector<int>> {
+                 { 0, 5, 9 }, { 12, 20, 21 }, { 30 } });
+}
+
+TEST_CASE("logarithmic invocations of predicate")
+{
+    // 16 chunks of 1024 elements each.
+    std::vector<int> input;
+    for (int i = 0; i < 16 * 1024; ++i) {
+        input.push_back(i / 1024);
+    }
+
+    int invocations = 0;
+    auto view = input | views::chunk_by_sorted([&](int lhs, int rhs) {
+                    ++invocations;
+                    return lhs == rhs;
+                });
+    CHECK_EQ(std::ranges::distance(view), 16);
+    CHECK_LE(invocations, 16 * 2 * 12);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,69 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/chunk_exact_view.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("chunk_exact_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<int>;
+    static_assert(
+        std::same_as<decltype(views::chunk_exact<2>(
+                         std::declval<input_type&>())),
+                     ranges::chunk_exact_view<std::views::all_t<input_type&>,
+                                              2>>);
+    static_assert(
+        std::same_as<
+            decltype(std::declval<input_type&>() | views::chunk_exact<2>),
+            ranges::chunk_exact_view<std::views::all_t<input_type&>, 2>>);
+}
+
+TEST_CASE("random_access_range")
+{
+    auto input = std::vector { 0, 1, 2, 3, 4, 5, 6 };
+    auto view = input | views::chunk_exact<3>;
+    using view_type = decltype(view);
+    static_assert(std::ranges::random_access_range<view_type>);
+    static_assert(std::ranges::sized_range<view_type>);
+    static_assert(std::ranges::common_range<view_type>);
+    static_assert(std::same_as<std::ranges::range_reference_t<view_type>,
+                               std::span<int, 3>>);
+    static_assert(std::same_as<std::ranges::range_reference_t<const view_type>,
+                               std::span<int, 3>>);
+
+    CHECK_EQ(std::ranges::size(view), 2);
+    auto curr = std::ranges::begin(view);
+    CHECK(std::ranges::equal(*curr, std::array { 0, 1, 2 }));
+    CHECK(std::ranges::equal(curr[1], std::array { 3, 4, 5 }));
+    ++curr;
+    CHECK(std::ranges::equal(*curr, std::array { 3, 4, 5 }));
+    ++curr;
+    CHECK_EQ(curr, std::ranges::end(view));
+    CHECK_EQ(curr - std::ranges::begin(view), 2);
+    CHECK_EQ(curr - 2, std::ranges::begin(view));
+    CHECK(std::ranges::equal(view.remainder(), std::array { 6 }));
+
+    for (auto chunk : view) {
+        chunk[0] = -1;
+    }
+    CHECK_EQ(input, std::vector { -1, 1, 2, -1, 4, 5, 6 });
+}
+
+TEST_CASE("without remainder")
+{
+    static const auto input = std::array { 0, 1, 2, 3 };
+    auto view = input | views::chunk_exact<2>;
+    CHECK_EQ(std::ranges::size(view), 2);
+    CHECK(view.remainder().empty());
+
+    auto empty = std::span<const int>() | views::chunk_exact<2>;
+    CHECK(std::ranges::empty(empty));
+    CHECK(empty.remainder().empty());
+}
+
+TEST_SUITE_END();
@@ -106,4 +106,18 @@ TEST_CASE("random_access_range")
     CHECK_EQ(curr, std::ranges::begin(view));
 }
 
+TEST_CASE("contiguous_range")
+{
+    static const auto input = std::vector { 0, 1, 2, 3, 4 };
+    auto view = input | views::chunk(2);
+    using view_type = decltype(view);
+    static_assert(std::same_as<std::ranges::range_value_t<view_type>,
+                               std::span<const int>>);
+    auto curr = std::ranges::begin(view);
+    CHECK(std::ranges::equal(*curr, std::vector { 0, 1 }));
+    CHECK_EQ(curr[2].size(), 1);
+    CHECK_EQ(curr[2].data(), input.data() + 4);
+    CHECK_EQ(std::ranges::distance(view), 3);
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,119 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/algorithm/fold.hpp>
+#include <iris/ranges/view/concat_ranges_view.hpp>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("concat_ranges_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<std::span<int>>;
+    using view_type
+        = ranges::concat_ranges_view<std::views::all_t<input_type&>>;
+    static_assert(std::same_as<
+                  decltype(views::concat_ranges(std::declval<input_type&>())),
+                  view_type>);
+    static_assert(std::same_as<decltype(std::declval<input_type&>()
+                                        | views::concat_ranges),
+                               view_type>);
+}
+
+TEST_CASE("random_access_range")
+{
+    int buffer0[] = { 0, 1, 2 };
+    int buffer1[] = { 3 };
+    int buffer2[] = { 4, 5 };
+    auto shards = std::vector<std::span<int>> {
+        {}, buffer0, {}, buffer1, buffer2, {},
+    };
+    auto view = views::concat_ranges(shards);
+    using view_type = decltype(view);
+    static_assert(std::ranges::random_access_range<view_type>);
+    static_assert(std::ranges::sized_range<view_type>);
+    static_assert(std::ranges::common_range<view_type>);
+    static_assert(
+        std::same_as<std::ranges::range_reference_t<view_type>, int&>);
+
+    CHECK_EQ(std::ranges::size(view), 6);
+    CHECK(std::ranges::equal(view, std::views::iota(0, 6)));
+    CHECK(std::ranges::equal(view | std::views::reverse,
+                             std::views::iota(0, 6) | std::views::reverse));
+
+    const auto first = std::ranges::begin(view);
+    const auto last = std::ranges::end(view);
+    CHECK_EQ(last - first, 6);
+    for (int i = 0; i <= 6; ++i) {
+        auto it = first + i;
+        CHECK_EQ(it - first, i);
+        CHECK_EQ(last - it, 6 - i);
+        CHECK_EQ(it, std::ranges::next(first, i));
+        CHECK_EQ(it - i, first);
+        if (i < 6) {
+            CHECK_EQ(*it, i);
+            CHECK_EQ(first[i], i);
+        }
+        for (int j = 0; j <= 6; ++j) {
+            CHECK_EQ(it + (j - i), first + j);
+            CHECK_EQ(i < j, it < first + j);
+        }
+    }
+
+    view[4] = 40;
+    CHECK_EQ(buffer2[0], 40);
+}
+
+TEST_CASE("empty")
+{
+    auto shards = std::vector<std::vector<int>> {};
+    auto view = views::concat_ranges(shards);
+    CHECK(std::ranges::empty(view));
+    CHECK_EQ(std::ranges::begin(view), std::ranges::end(view));
+
+    shards = { {}, {} };
+    auto view2 = views::concat_ranges(shards);
+    CHECK(std::ranges::empty(view2));
+    CHECK_EQ(std::ranges::begin(view2), std::ranges::end(view2));
+    CHECK_EQ(std::ranges::end(view2) - std::ranges::begin(view2), 0);
+}
+
+TEST_CASE("copies do not share the cached sizes")
+{
+    auto shards = std::vector<std::vector<int>> { { 0, 1 }, { 2 } };
+    auto view = views::concat_ranges(shards);
+    CHECK(std::ranges::equal(view, std::vector { 0, 1, 2 }));
+
+    // the copy caches the sizes of the ranges when its iteration begins.
+    shards[1].push_back(3);
+    auto copy = view;
+    CHECK(std::ranges::equal(copy, std::vector { 0, 1, 2, 3 }));
+    CHECK_EQ(std::ranges::end(copy) - std::ranges::begin(copy), 4);
+}
+
+TEST_CASE("size is computed once")
+{
+    auto shards = std::vector<std::vector<int>> { { 0, 1 }, { 2 } };
+    auto view = views::concat_ranges(shards);
+    CHECK_EQ(view.size(), 3);
+
+    // like the iteration, the size uses the cached sizes of the ranges.
+    shards[1].push_back(3);
+    CHECK_EQ(view.size(), 3);
+}
+
+TEST_CASE("algorithms")
+{
+    auto shards = std::vector<std::vector<int>> { { 5, 3 }, {}, { 4, 0 } };
+    auto view = views::concat_ranges(shards);
+    std::ranges::sort(view);
+    CHECK_EQ(shards, std::vector<std::vector<int>> { { 0, 3 }, {}, { 4, 5 } });
+    CHECK(std::ranges::binary_search(view, 4));
+    CHECK_EQ(ranges::fold_left(view, 0, std::plus {}), 12);
+}
+
+TEST_SUITE_END();
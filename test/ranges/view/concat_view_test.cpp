@@ -5,6 +5,7 @@
 #include <array>
 #include <forward_list>
 #include <list>
+#include <span>
 #include <vector>
 
 using namespace iris;
@@ -134,4 +135,128 @@ TEST_CASE("random_access_range")
     CHECK_EQ(curr, std::ranges::begin(view));
 }
 
+TEST_CASE("random access with empty bases")
+{
+    auto input0 = std::vector<int> {};
+    auto input1 = std::vector { 0, 1, 2 };
+    auto input2 = std::vector<int> {};
+    auto input3 = std::vector { 3 };
+    auto input4 = std::vector { 4, 5 };
+    auto input5 = std::vector<int> {};
+    auto view = views::concat(input0, input1, input2, input3, input4, input5);
+    const auto& const_view = view;
+
+    auto test = [](auto&& view) {
+        const auto first = std::ranges::begin(view);
+        const auto last = std::ranges::end(view);
+        CHECK_EQ(last - first, 6);
+        CHECK_EQ(std::default_sentinel - first, 6);
+        CHECK_EQ(first - std::default_sentinel, -6);
+        for (int i = 0; i <= 6; ++i) {
+            auto it = first + i;
+            CHECK_EQ(it - first, i);
+            CHECK_EQ(last - it, 6 - i);
+            CHECK_EQ(it, std::ranges::next(first, i));
+            if (i < 6) {
+                CHECK_EQ(*it, i);
+                CHECK_EQ(first[i], i);
+            }
+            for (int j = 0; j <= 6; ++j) {
+                CHECK_EQ((it + (j - i)) - first, j);
+                CHECK_EQ(it + (j - i), first + j);
+            }
+        }
+        CHECK_EQ(first + 6, last);
+        CHECK_EQ(last - 6, first);
+    };
+    test(view);
+    test(const_view);
+
+    static_assert(std::same_as<std::ranges::iterator_t<decltype(view)>,
+                               std::ranges::iterator_t<decltype(const_view)>>);
+}
+
+namespace {
+// a span which counts the calls of `size()`.
+class counted_span : public std::ranges::view_interface<counted_span> {
+public:
+    counted_span() = default;
+
+    counted_span(std::span<const int> span, int& calls)
+        : span_(span)
+        , calls_(&calls)
+    {
+    }
+
+    const int* begin() const
+    {
+        return span_.data();
+    }
+
+    const int* end() const
+    {
+        return span_.data() + span_.size();
+    }
+
+    std::size_t size() const
+    {
+        ++*calls_;
+        return span_.size();
+    }
+
+private:
+    std::span<const int> span_;
+    int* calls_ = nullptr;
+};
+}
+
+TEST_CASE("random access does not query the sizes of the bases")
+{
+    static const int input0[] = { 0, 1, 2 };
+    static const int input1[] = { 3 };
+    static const int input2[] = { 4, 5 };
+    int calls = 0;
+    const auto view = views::concat(counted_span(input0, calls),
+                                    counted_span(input1, calls),
+                                    counted_span(input2, calls));
+    static_assert(std::ranges::random_access_range<decltype(view)>);
+    CHECK_EQ(calls, 3);
+
+    // the sizes are stored when the view is constructed.
+    calls = 0;
+    auto first = std::ranges::begin(view);
+    auto last = std::ranges::end(view);
+    for (int i = 0; i < 6; ++i) {
+        CHECK_EQ(first[i], i);
+        CHECK_EQ(*(last - (6 - i)), i);
+        CHECK_EQ((first + i) - first, i);
+        CHECK_EQ(last - (first + i), 6 - i);
+    }
+    CHECK_EQ(calls, 0);
+}
+
+TEST_CASE("random access over views which are not simple")
+{
+    auto identity
+        = std::views::transform([n = 0](int i) mutable { return i + n; });
+    auto view = views::concat(std::views::iota(0, 3) | identity,
+                              std::views::iota(3, 3) | identity,
+                              std::views::iota(3, 6) | identity);
+    static_assert(!std::ranges::range<const decltype(view)>);
+    static_assert(std::ranges::random_access_range<decltype(view)>);
+
+    auto first = std::ranges::begin(view);
+    auto last = std::ranges::end(view);
+    CHECK_EQ(last - first, 6);
+    for (int i = 0; i < 6; ++i) {
+        CHECK_EQ(first[i], i);
+        CHECK_EQ(*(last - (6 - i)), i);
+    }
+    CHECK_EQ(std::ranges::begin(view) + 6, last);
+
+    auto copy = view;
+    CHECK_EQ(std::ranges::end(copy) - std::ranges::begin(copy), 6);
+    CHECK_EQ(std::ranges::begin(copy)[4], 4);
+}
+
 TEST_SUITE_END();
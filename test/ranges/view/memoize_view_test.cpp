@@ -0,0 +1,75 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/adjacent_transform_view.hpp>
+#include <iris/ranges/view/memoize_view.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("memoize_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<int>;
+    using view_type = ranges::memoize_view<std::views::all_t<input_type&>>;
+    static_assert(
+        std::same_as<decltype(views::memoize(std::declval<input_type&>())),
+                     view_type>);
+    static_assert(
+        std::same_as<decltype(std::declval<input_type&>() | views::memoize),
+                     view_type>);
+    static_assert(std::ranges::random_access_range<view_type>);
+    static_assert(std::ranges::sized_range<view_type>);
+    static_assert(std::ranges::common_range<view_type>);
+    static_assert(
+        std::same_as<std::ranges::range_reference_t<view_type>, const int&>);
+}
+
+TEST_CASE("each element is computed once")
+{
+    const auto input = std::vector { 5, 3, 8, 1, 9, 2 };
+    int invocations = 0;
+    auto view = input | views::pairwise_transform([&](int lhs, int rhs) {
+                    ++invocations;
+                    return lhs * rhs;
+                })
+        | views::memoize;
+    CHECK_EQ(std::ranges::size(view), 5);
+    CHECK_EQ(invocations, 0);
+
+    CHECK_EQ(view[3], 9);
+    CHECK_EQ(invocations, 1);
+
+    const auto expected = std::vector { 15, 24, 8, 9, 18 };
+    for (int pass = 0; pass < 3; ++pass) {
+        CHECK(std::ranges::equal(view, expected));
+        // a copy of the view would start with an empty buffer.
+        CHECK(std::ranges::equal(
+            std::ranges::subrange(view.begin(), view.end())
+                | std::views::reverse,
+            expected | std::views::reverse));
+    }
+    CHECK_EQ(*std::ranges::max_element(view), 24);
+    CHECK_EQ(std::ranges::end(view) - std::ranges::begin(view), 5);
+    CHECK_EQ(invocations, 5);
+}
+
+TEST_CASE("copies do not share the buffer")
+{
+    const auto input = std::vector { 0, 1, 2 };
+    int invocations = 0;
+    auto view = input | std::views::transform([&](int i) {
+                    ++invocations;
+                    return i + 1;
+                })
+        | views::memoize;
+    CHECK(std::ranges::equal(view, std::vector { 1, 2, 3 }));
+    auto copy = view;
+    CHECK(std::ranges::equal(copy, std::vector { 1, 2, 3 }));
+    CHECK(std::ranges::equal(view, std::vector { 1, 2, 3 }));
+    CHECK_EQ(invocations, 6);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,139 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/enumerate_view.hpp>
+#include <iris/ranges/view/prefetch_view.hpp>
+
+#include <forward_list>
+#include <list>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("prefetch_view");
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using input_type = std::vector<int>;
+    using view_type = ranges::prefetch_view<std::views::all_t<input_type&>,
+                                            std::identity>;
+    static_assert(std::same_as<decltype(views::prefetch(
+                                   std::declval<input_type&>(), 8)),
+                               view_type>);
+    static_assert(std::same_as<decltype(std::declval<input_type&>()
+                                        | views::prefetch(8)),
+                               view_type>);
+    static_assert(std::same_as<decltype(views::prefetch_by(
+                                   std::declval<input_type&>(),
+                                   std::identity {}, 8)),
+                               view_type>);
+    static_assert(std::same_as<decltype(std::declval<input_type&>()
+                                        | views::prefetch_by(
+                                            std::identity {}, 8)),
+                               view_type>);
+}
+
+TEST_CASE("iterator category is preserved")
+{
+    static_assert(std::ranges::random_access_range<decltype(views::prefetch(
+                      std::declval<std::vector<int>&>(), 8))>);
+    static_assert(!std::ranges::contiguous_range<decltype(views::prefetch(
+                      std::declval<std::vector<int>&>(), 8))>);
+    static_assert(std::ranges::bidirectional_range<decltype(views::prefetch(
+                      std::declval<std::list<int>&>(), 8))>);
+    static_assert(!std::ranges::random_access_range<decltype(views::prefetch(
+                      std::declval<std::list<int>&>(), 8))>);
+    static_assert(std::ranges::forward_range<decltype(views::prefetch(
+                      std::declval<std::forward_list<int>&>(), 8))>);
+    static_assert(!std::ranges::bidirectional_range<decltype(views::prefetch(
+                      std::declval<std::forward_list<int>&>(), 8))>);
+    static_assert(std::ranges::sized_range<decltype(views::prefetch(
+                      std::declval<std::vector<int>&>(), 8))>);
+}
+
+TEST_CASE("random_access_range")
+{
+    auto input = std::vector { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    for (int distance : { 0, 1, 3, 10, 20 }) {
+        auto view = input | views::prefetch(distance);
+        CHECK(std::ranges::equal(view, input));
+        CHECK(std::ranges::equal(view | std::views::reverse,
+                                 input | std::views::reverse));
+        CHECK_EQ(std::ranges::size(view), 10);
+        CHECK_EQ(view[4], 4);
+        CHECK_EQ(*(view.begin() + 7), 7);
+        CHECK_EQ(view.end() - view.begin(), 10);
+
+        // the prefetch distance is kept after jumps in both directions.
+        auto it = view.end() - 5;
+        CHECK(std::ranges::equal(std::ranges::subrange(it, view.end()),
+                                 std::vector { 5, 6, 7, 8, 9 }));
+        it -= 3;
+        CHECK(std::ranges::equal(std::ranges::subrange(it, view.end()),
+                                 std::vector { 2, 3, 4, 5, 6, 7, 8, 9 }));
+    }
+
+    auto view = input | views::prefetch(2);
+    *view.begin() = 10;
+    CHECK_EQ(input[0], 10);
+}
+
+TEST_CASE("bidirectional_range")
+{
+    const auto input = std::list { 0, 1, 2, 3, 4 };
+    for (int distance : { 0, 2, 8 }) {
+        auto view = input | views::prefetch(distance);
+        CHECK(std::ranges::equal(view, input));
+        CHECK(std::ranges::equal(view | std::views::reverse,
+                                 input | std::views::reverse));
+
+        // walks to the end and back again.
+        auto it = view.begin();
+        for (int i = 0; i < 5; ++i) {
+            ++it;
+        }
+        CHECK_EQ(it, view.end());
+        for (int i = 4; i >= 0; --i) {
+            CHECK_EQ(*--it, i);
+        }
+        CHECK(std::ranges::equal(std::ranges::subrange(it, view.end()),
+                                 input));
+    }
+}
+
+TEST_CASE("prefetch_by")
+{
+    const auto table = std::vector { 10, 11, 12, 13, 14, 15 };
+    const auto indices = std::vector<std::size_t> { 5, 0, 3, 3, 1 };
+    int projections = 0;
+    auto view = indices
+        | views::prefetch_by(
+                    [&](std::size_t i) {
+                        ++projections;
+                        return table.data() + i;
+                    },
+                    2)
+        | views::enumerate;
+    std::vector<int> gathered;
+    for (auto [index, i] : view) {
+        CHECK_EQ(indices[static_cast<std::size_t>(index)], i);
+        gathered.push_back(table[i]);
+    }
+    CHECK_EQ(gathered, std::vector { 15, 10, 13, 13, 11 });
+    CHECK_EQ(projections, 4);
+}
+
+TEST_CASE("non common range")
+{
+    auto input = std::views::iota(0) | std::views::take_while([](int i) {
+                     return i < 5;
+                 })
+        | std::views::transform([](int) -> const int& {
+                     static const int value = 1;
+                     return value;
+                 });
+    auto view = input | views::prefetch(3);
+    static_assert(!std::ranges::common_range<decltype(view)>);
+    CHECK_EQ(std::ranges::distance(view), 5);
+}
+
+TEST_SUITE_END();
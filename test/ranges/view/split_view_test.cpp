@@ -0,0 +1,107 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/ranges/view/split_view.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("split_view");
+
+template <typename Range>
+std::vector<std::string_view> pieces_of(Range&& range)
+{
+    return std::vector<std::string_view>(std::ranges::begin(range),
+                                         std::ranges::end(range));
+}
+
+template <typename Pattern>
+std::vector<std::string_view> std_split(std::string_view input,
+                                        Pattern pattern)
+{
+    std::vector<std::string_view> result;
+    for (auto piece : std::views::split(input, pattern)) {
+        result.emplace_back(piece.begin(), piece.end());
+    }
+    return result;
+}
+
+TEST_CASE("result of applying range adaptor object")
+{
+    using view_type = decltype(views::split(std::string_view(), ','));
+    static_assert(std::ranges::forward_range<view_type>);
+    static_assert(std::ranges::common_range<view_type>);
+    static_assert(std::same_as<std::ranges::range_value_t<view_type>,
+                               std::string_view>);
+    static_assert(
+        std::same_as<decltype(std::string_view() | views::split(',')),
+                     view_type>);
+    static_assert(std::same_as<
+                  std::ranges::range_value_t<decltype(views::split_any(
+                      std::u8string_view(), u8",;"))>,
+                  std::u8string_view>);
+}
+
+TEST_CASE("split")
+{
+    const auto input = std::string("a,b,,cd,");
+    CHECK_EQ(pieces_of(input | views::split(',')),
+             std::vector<std::string_view> { "a", "b", "", "cd", "" });
+    CHECK_EQ(pieces_of(views::split(input, ",,")),
+             std::vector<std::string_view> { "a,b", "cd," });
+    CHECK_EQ(pieces_of(views::split(input, std::string(";"))),
+             std::vector<std::string_view> { "a,b,,cd," });
+    CHECK_EQ(pieces_of(views::split(std::string_view(), ',')),
+             std::vector<std::string_view> {});
+    CHECK_EQ(pieces_of(views::split(std::string_view("ab"), "")),
+             std::vector<std::string_view> { "a", "b" });
+}
+
+TEST_CASE("split_any")
+{
+    const auto input = std::string_view("key=value; other = 1,2");
+    CHECK_EQ(pieces_of(input | views::split_any(" =;,")),
+             std::vector<std::string_view> {
+                 "key", "value", "", "other", "", "", "1", "2" });
+    CHECK_EQ(pieces_of(input | views::split_any("")),
+             std::vector<std::string_view> { input });
+}
+
+TEST_CASE("same pieces as std::views::split")
+{
+    // long enough to be searched in blocks of 16 characters.
+    std::string input;
+    for (int i = 0; i < 200; ++i) {
+        input += static_cast<char>('a' + (i * 7) % 11);
+        if (i % 13 == 0) {
+            input += ',';
+        }
+        if (i % 29 == 0) {
+            input += ";,";
+        }
+    }
+
+    for (auto pattern : { ",", ";,", "b", "bi", "z" }) {
+        CHECK_EQ(pieces_of(views::split(input, pattern)),
+                 std_split(input, std::string_view(pattern)));
+    }
+
+    for (auto delimiters : { ",;", "ab", "abcdefgh", "abcdefghi", "z" }) {
+        auto expected = std::vector<std::string_view> {};
+        auto first = input.data();
+        for (auto it = input.data(); it != input.data() + input.size();
+             ++it) {
+            if (std::string_view(delimiters).find(*it)
+                != std::string_view::npos) {
+                expected.emplace_back(first, it);
+                first = it + 1;
+            }
+        }
+        expected.emplace_back(first, input.data() + input.size());
+        CHECK_EQ(pieces_of(views::split_any(input, delimiters)), expected);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,101 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/run_loop.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("run_loop");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached push_on(run_loop& loop, std::vector<int>& values, int value)
+{
+    co_await loop.schedule();
+    values.push_back(value);
+}
+
+TEST_CASE("run in FIFO order")
+{
+    run_loop loop;
+    std::vector<int> values;
+    for (int i = 0; i < 5; ++i) {
+        push_on(loop, values, i);
+    }
+    CHECK(values.empty());
+
+    loop.finish();
+    loop.run();
+    CHECK_EQ(values, std::vector { 0, 1, 2, 3, 4 });
+
+    // the loop can be run again.
+    push_on(loop, values, 5);
+    loop.finish();
+    loop.run();
+    CHECK_EQ(values.back(), 5);
+}
+
+detached count_on(run_loop& loop, int& count, std::thread::id& thread)
+{
+    co_await loop.schedule();
+    ++count;
+    thread = std::this_thread::get_id();
+}
+
+TEST_CASE("schedule from other threads")
+{
+    run_loop loop;
+    int count = 0;
+    std::thread::id thread;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&] {
+            for (int j = 0; j < 100; ++j) {
+                count_on(loop, count, thread);
+            }
+        });
+    }
+    std::thread finisher([&] {
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        loop.finish();
+    });
+
+    loop.run();
+    finisher.join();
+    CHECK_EQ(count, 400);
+    CHECK_EQ(thread, std::this_thread::get_id());
+}
+
+TEST_SUITE_END();
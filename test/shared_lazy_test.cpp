@@ -0,0 +1,161 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/lazy.hpp>
+#include <iris/shared_lazy.hpp>
+
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("shared_lazy");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+class manual_event {
+public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        waiter_ = handle;
+    }
+
+    void await_resume() noexcept { }
+
+    void set()
+    {
+        std::exchange(waiter_, {}).resume();
+    }
+
+private:
+    std::coroutine_handle<> waiter_;
+};
+}
+
+shared_lazy<int> compute(int& count, manual_event& event)
+{
+    ++count;
+    co_await event;
+    co_return 42;
+}
+
+detached consume(shared_lazy<int> task, std::vector<const int*>& results)
+{
+    results.push_back(&co_await task);
+}
+
+TEST_CASE("shared_lazy<int> resumes every awaiter")
+{
+    int count = 0;
+    manual_event event;
+    std::vector<const int*> results;
+    auto task = compute(count, event);
+    CHECK_EQ(count, 0);
+    CHECK(!task.ready());
+
+    consume(task, results);
+    consume(task, results);
+    consume(task, results);
+    CHECK_EQ(count, 1);
+    CHECK(results.empty());
+
+    event.set();
+    CHECK(task.ready());
+    REQUIRE_EQ(results.size(), 3);
+    for (auto result : results) {
+        CHECK_EQ(*result, 42);
+        CHECK_EQ(result, results.front());
+    }
+
+    consume(task, results);
+    CHECK_EQ(count, 1);
+    REQUIRE_EQ(results.size(), 4);
+    CHECK_EQ(results.back(), results.front());
+}
+
+shared_lazy<> generate_void(int& value)
+{
+    ++value;
+    co_return;
+}
+
+lazy<int> await_twice(shared_lazy<> task, int& value)
+{
+    co_await task;
+    co_await task;
+    co_return value;
+}
+
+TEST_CASE("shared_lazy<>")
+{
+    int value = 0;
+    CHECK_EQ(await_twice(generate_void(value), value).sync_wait(), 1);
+}
+
+shared_lazy<int> throws_exception()
+{
+    throw std::runtime_error("shared_lazy");
+    co_return 0;
+}
+
+lazy<int> catch_exception(shared_lazy<int> task)
+{
+    int caught = 0;
+    for (int i = 0; i < 2; ++i) {
+        try {
+            co_await task;
+        } catch (const std::runtime_error&) {
+            ++caught;
+        }
+    }
+    co_return caught;
+}
+
+TEST_CASE("shared_lazy body throws exception")
+{
+    CHECK_EQ(catch_exception(throws_exception()).sync_wait(), 2);
+}
+
+TEST_CASE("copy and move")
+{
+    int value = 0;
+    auto task = generate_void(value);
+    auto copy = task;
+    auto moved = std::move(task);
+    CHECK(!copy.ready());
+    CHECK(!moved.ready());
+    CHECK_EQ(await_twice(copy, value).sync_wait(), 1);
+    CHECK(moved.ready());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,120 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/async_scope.hpp>
+#include <iris/lazy.hpp>
+#include <iris/sync_wait.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("sync_wait");
+
+namespace {
+class thread_scheduler {
+public:
+    ~thread_scheduler()
+    {
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    auto schedule() noexcept
+    {
+        class awaitable {
+        public:
+            explicit awaitable(thread_scheduler& scheduler) noexcept
+                : scheduler_(scheduler)
+            {
+            }
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                scheduler_.threads_.emplace_back([handle] { handle.resume(); });
+            }
+
+            void await_resume() noexcept { }
+
+        private:
+            thread_scheduler& scheduler_;
+        };
+
+        return awaitable(*this);
+    }
+
+private:
+    std::vector<std::thread> threads_;
+};
+}
+
+lazy<int> get(int value)
+{
+    co_return value;
+}
+
+lazy<int> throw_runtime_error()
+{
+    throw std::runtime_error("sync_wait");
+    co_return 0;
+}
+
+lazy<std::thread::id> this_thread_id()
+{
+    co_return std::this_thread::get_id();
+}
+
+TEST_CASE("sync_wait(awaitable)")
+{
+    CHECK_EQ(sync_wait(get(1)), 1);
+    auto task = get(2);
+    CHECK_EQ(sync_wait(std::move(task)), 2);
+    CHECK_THROWS_AS(sync_wait(throw_runtime_error()), std::runtime_error);
+    sync_wait(std::suspend_never());
+    CHECK_EQ(sync_wait(this_thread_id()), std::this_thread::get_id());
+}
+
+lazy<int> sum_on(run_loop& loop, std::thread::id caller, int n)
+{
+    async_scope scope;
+    int sum = 0;
+    auto add = [&](int value) -> lazy<> {
+        CHECK_EQ(std::this_thread::get_id(), caller);
+        sum += value;
+        co_return;
+    };
+    for (int i = 1; i <= n; ++i) {
+        scope.spawn(loop, add(i));
+    }
+    co_await scope.join();
+    co_return sum;
+}
+
+TEST_CASE("sync_wait(run_loop, awaitable)")
+{
+    run_loop loop;
+    auto caller = std::this_thread::get_id();
+    CHECK_EQ(sync_wait(loop, sum_on(loop, caller, 100)), 5050);
+    CHECK_EQ(sync_wait(loop, this_thread_id()), caller);
+    CHECK_THROWS_AS(sync_wait(loop, throw_runtime_error()),
+                    std::runtime_error);
+}
+
+TEST_CASE("sync_wait(scheduler, awaitable)")
+{
+    thread_scheduler scheduler;
+    CHECK_NE(sync_wait(scheduler, this_thread_id()),
+             std::this_thread::get_id());
+    CHECK_EQ(sync_wait(scheduler, get(3)), 3);
+    CHECK_THROWS_AS(sync_wait(scheduler, throw_runtime_error()),
+                    std::runtime_error);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,76 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/thread_pool.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("thread_pool");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+detached record(thread_pool& pool,
+                std::mutex& mutex,
+                std::set<std::thread::id>& threads,
+                std::atomic<int>& count)
+{
+    co_await pool.schedule();
+    {
+        std::unique_lock lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    }
+    ++count;
+}
+
+TEST_CASE("schedule")
+{
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> count = 0;
+    {
+        thread_pool pool(4);
+        CHECK_EQ(pool.size(), 4);
+        for (int i = 0; i < 1000; ++i) {
+            record(pool, mutex, threads, count);
+        }
+    }
+
+    // all scheduled coroutines are resumed before the pool is destroyed.
+    CHECK_EQ(count, 1000);
+    CHECK_LE(threads.size(), 4);
+    CHECK_EQ(threads.count(std::this_thread::get_id()), 0);
+}
+
+TEST_SUITE_END();
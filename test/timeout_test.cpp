@@ -0,0 +1,221 @@
+#include <thirdparty/test.hpp>
+
+#include <iris/timeout.hpp>
+
+#if defined(__linux__)
+
+#include <memory>
+#include <thread>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("timeout");
+
+namespace {
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() noexcept
+        {
+            return {};
+        }
+
+        auto initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        auto final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept { }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+}
+
+lazy<int> sleep_then_return(io_context& context,
+                            std::chrono::milliseconds duration,
+                            int value)
+{
+    co_await context.sleep_for(duration);
+    co_return value;
+}
+
+lazy<> sleep_then_count(io_context& context,
+                        std::chrono::milliseconds duration,
+                        int& count)
+{
+    co_await context.sleep_for(duration);
+    ++count;
+}
+
+lazy<int> return_immediately(int value)
+{
+    co_return value;
+}
+
+detached await_with_timeout(io_context& context,
+                            lazy<int> task,
+                            std::chrono::milliseconds duration,
+                            expected<int, timeout_error>& result)
+{
+    result = co_await with_timeout(context, std::move(task), duration);
+    context.stop();
+}
+
+detached await_void_with_timeout(io_context& context,
+                                 lazy<> task,
+                                 std::chrono::milliseconds duration,
+                                 expected<void, timeout_error>& result)
+{
+    co_await context.schedule();
+    result = co_await with_timeout(context, std::move(task), duration);
+}
+
+TEST_CASE("task completes")
+{
+    io_context context;
+    expected<int, timeout_error> result = unexpected(timeout_error {});
+    await_with_timeout(context,
+                       sleep_then_return(context, std::chrono::milliseconds(1),
+                                         42),
+                       std::chrono::seconds(10), result);
+    auto start = std::chrono::steady_clock::now();
+    context.run();
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+    CHECK_EQ(result, 42);
+}
+
+TEST_CASE("task completes synchronously")
+{
+    io_context context;
+    expected<int, timeout_error> result = unexpected(timeout_error {});
+    // awaited outside of the event loop, the timer is disarmed through
+    // a posted operation.
+    await_with_timeout(context, return_immediately(7),
+                       std::chrono::seconds(10), result);
+    CHECK_EQ(result, 7);
+    context.restart();
+    context.poll();
+}
+
+TEST_CASE("task times out")
+{
+    io_context context;
+    expected<int, timeout_error> result = 0;
+    await_with_timeout(context,
+                       sleep_then_return(context,
+                                         std::chrono::milliseconds(200), 42),
+                       std::chrono::milliseconds(10), result);
+    context.run();
+    CHECK_EQ(result, unexpected(timeout_error {}));
+
+    // the timed out task keeps running detached.
+    context.restart();
+    context.run_for(std::chrono::milliseconds(300));
+}
+
+TEST_CASE("void task")
+{
+    io_context context;
+    int count = 0;
+    expected<void, timeout_error> fast = unexpected(timeout_error {});
+    expected<void, timeout_error> slow;
+    await_void_with_timeout(
+        context, sleep_then_count(context, std::chrono::milliseconds(1), count),
+        std::chrono::seconds(10), fast);
+    await_void_with_timeout(
+        context,
+        sleep_then_count(context, std::chrono::milliseconds(100), count),
+        std::chrono::milliseconds(10), slow);
+    context.run_for(std::chrono::milliseconds(300));
+    CHECK(fast);
+    CHECK(!slow);
+    CHECK_EQ(count, 2);
+}
+
+TEST_CASE("timer armed from another thread")
+{
+    io_context context;
+    expected<int, timeout_error> result = 0;
+    std::thread thread([&]() {
+        await_with_timeout(context,
+                           sleep_then_return(context,
+                                             std::chrono::milliseconds(100),
+                                             42),
+                           std::chrono::milliseconds(10), result);
+    });
+    thread.join();
+    context.run();
+    CHECK_EQ(result, unexpected(timeout_error {}));
+
+    context.restart();
+    context.run_for(std::chrono::milliseconds(200));
+}
+
+class resume_later {
+public:
+    explicit resume_later(std::coroutine_handle<>& handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        handle_ = handle;
+    }
+
+    void await_resume() noexcept { }
+
+private:
+    std::coroutine_handle<>& handle_;
+};
+
+// `frame` is owned by the frame of the coroutine until it is destroyed.
+lazy<int> wait_for_resume(std::coroutine_handle<>& handle,
+                          std::shared_ptr<int> frame)
+{
+    co_await resume_later(handle);
+    co_return *frame;
+}
+
+detached resume_on_loop(io_context& context, std::coroutine_handle<>& handle)
+{
+    co_await context.schedule();
+    handle.resume();
+}
+
+TEST_CASE("task completes before the timer is inserted")
+{
+    io_context context;
+    std::coroutine_handle<> handle;
+    auto frame = std::make_shared<int>(1);
+    expected<int, timeout_error> result = unexpected(timeout_error {});
+    // armed outside of the event loop, the insertion of the timer is posted
+    // after the resumption of the task, which completes first.
+    resume_on_loop(context, handle);
+    await_with_timeout(context, wait_for_resume(handle, frame),
+                       std::chrono::seconds(10), result);
+    context.run();
+    CHECK_EQ(result, 1);
+
+    // the timer is not left armed, the state and the task are released.
+    CHECK_EQ(frame.use_count(), 1);
+}
+
+TEST_SUITE_END();
+
+#endif
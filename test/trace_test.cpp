@@ -0,0 +1,138 @@
+#if !defined(IRIS_ENABLE_TRACING)
+#define IRIS_ENABLE_TRACING
+#endif
+
+#include <thirdparty/test.hpp>
+
+#include <iris/generator.hpp>
+#include <iris/lazy.hpp>
+#include <iris/trace.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace iris;
+
+TEST_SUITE_BEGIN("trace");
+
+namespace {
+std::vector<trace_event> snapshot_of(const char* name)
+{
+    auto events = trace_snapshot();
+    std::erase_if(events, [&](const auto& event) {
+        return std::string(event.name) != name;
+    });
+    return events;
+}
+
+std::vector<trace_event_kind> kinds_of(const std::vector<trace_event>& events)
+{
+    std::vector<trace_event_kind> kinds;
+    for (auto& event : events) {
+        kinds.push_back(event.kind);
+    }
+    return kinds;
+}
+}
+
+lazy<int> inner()
+{
+    co_return 1;
+}
+
+lazy<int> outer()
+{
+    co_return co_await inner() + 1;
+}
+
+TEST_CASE("lazy")
+{
+    trace_clear();
+    CHECK_EQ(outer().sync_wait(), 2);
+
+    using enum trace_event_kind;
+    auto events = snapshot_of("lazy");
+    CHECK_EQ(kinds_of(events),
+             std::vector { create, resume, create, suspend, resume, complete,
+                           resume, complete });
+    CHECK_EQ(events[0].frame, events[1].frame);
+    CHECK_EQ(events[2].frame, events[4].frame);
+    CHECK_EQ(events[0].frame, events[3].frame);
+    CHECK_EQ(events[0].frame, events[7].frame);
+
+    auto sync_wait_events = snapshot_of("sync_wait");
+    CHECK_EQ(kinds_of(sync_wait_events),
+             std::vector { create, resume, suspend, resume, complete });
+}
+
+generator<int> nested_ints()
+{
+    co_yield 1;
+    co_yield 2;
+}
+
+generator<int> ints()
+{
+    co_yield 0;
+    co_yield ranges::elements_of(nested_ints());
+    co_yield 3;
+}
+
+TEST_CASE("generator")
+{
+    trace_clear();
+    std::vector<int> values;
+    for (auto value : ints()) {
+        values.push_back(value);
+    }
+    CHECK_EQ(values, std::vector { 0, 1, 2, 3 });
+
+    using enum trace_event_kind;
+    auto events = snapshot_of("generator");
+    CHECK_EQ(kinds_of(events),
+             std::vector {
+                 create,   resume, suspend,  // yield 0
+                 resume,   create, suspend,  // await nested
+                 resume,   suspend,          // yield 1
+                 resume,   suspend,          // yield 2
+                 resume,   complete,         // nested done
+                 resume,   suspend,          // yield 3
+                 resume,   complete,         // done
+             });
+}
+
+TEST_CASE("multiple threads")
+{
+    trace_clear();
+    std::thread([] { CHECK_EQ(inner().sync_wait(), 1); }).join();
+    CHECK_EQ(inner().sync_wait(), 1);
+
+    auto events = snapshot_of("lazy");
+    REQUIRE_EQ(events.size(), 6);
+    CHECK_NE(events.front().thread, events.back().thread);
+}
+
+TEST_CASE("chrome trace")
+{
+    trace_clear();
+    CHECK_EQ(outer().sync_wait(), 2);
+
+    std::ostringstream os;
+    write_chrome_trace(os, trace_snapshot());
+    auto json = os.str();
+    CHECK_EQ(json.find(R"({"traceEvents":[)"), 0);
+    CHECK_NE(json.find(R"("name":"lazy")"), std::string::npos);
+    CHECK_NE(json.find(R"("ph":"b")"), std::string::npos);
+    CHECK_NE(json.find(R"("ph":"B")"), std::string::npos);
+    CHECK_NE(json.find(R"("ph":"E")"), std::string::npos);
+    CHECK_NE(json.find(R"("ph":"e")"), std::string::npos);
+    CHECK_EQ(json.substr(json.size() - 3), "]}\n");
+
+    std::ostringstream empty;
+    write_chrome_trace(empty, {});
+    CHECK_EQ(empty.str(), "{\"traceEvents\":[\n]}\n");
+}
+
+TEST_SUITE_END();